@@ -34,6 +34,8 @@ message(STATUS "  EchoServer        : cmake --build . --target NetTcp_EchoServer
 message(STATUS "  EchoClientServer  : cmake --build . --target NetTcp_EchoClientServer --config ${CMAKE_BUILD_TYPE} ${PARALLEL_LEVEL}")
 message(STATUS "  FuzzDisconnectionClientServer : cmake --build . --target NetTcp_FuzzDisconnectionClientServer --config ${CMAKE_BUILD_TYPE} ${PARALLEL_LEVEL}")
 message(STATUS "  FuzzDisconnectionServerClient : cmake --build . --target NetTcp_FuzzDisconnectionServerClient --config ${CMAKE_BUILD_TYPE} ${PARALLEL_LEVEL}")
+message(STATUS "  TrafficReplay     : cmake --build . --target NetTcp_TrafficReplay --config ${CMAKE_BUILD_TYPE} ${PARALLEL_LEVEL}")
+message(STATUS "  IdleConnections   : cmake --build . --target NetTcp_IdleConnections --config ${CMAKE_BUILD_TYPE} ${PARALLEL_LEVEL}")
 endif()
 
 if(TARGET "${NETTCP_TARGET}Tests")
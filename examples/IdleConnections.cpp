@@ -0,0 +1,217 @@
+﻿
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Dependencies
+#include <Net/Tcp/NetTcp.hpp>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#ifdef _MSC_VER
+#    include <spdlog/sinks/msvc_sink.h>
+#endif
+
+// Qt
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QProcess>
+#include <QTcpSocket>
+#include <QTimer>
+
+// Stl
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#    include <unistd.h>
+#endif
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+std::shared_ptr<spdlog::logger> appLog = std::make_shared<spdlog::logger>("app");
+
+// Resident set size of the process in bytes. 0 if unknown
+static qint64 residentSetSize()
+{
+#ifdef Q_OS_LINUX
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if(!statm.open(QIODevice::ReadOnly))
+        return 0;
+    const auto fields = statm.readAll().split(' ');
+    if(fields.size() < 2)
+        return 0;
+    return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Measure the memory cost of idle clients in a Server.
+ * The server run in this process, clients are opened by a child process so they don't count in server RSS.
+ */
+class ServerApp
+{
+public:
+    uint16_t port = 9999;
+    int count = 1000;
+    bool slim = false;
+
+private:
+    net::tcp::Server server;
+    QProcess clients;
+    qint64 baseline = 0;
+    int connected = 0;
+
+public:
+    bool start()
+    {
+        server.setMaxClientCount(count);
+        server.setSlimMode(slim);
+        QObject::connect(&server, &net::tcp::Server::newClient,
+            [this](const QString&, const quint16)
+            {
+                if(++connected == count)
+                {
+                    appLog->info("{} clients connected, wait for memory to settle", count);
+                    QTimer::singleShot(2000, [this]() { report(); });
+                }
+            });
+
+        if(!server.start(port))
+        {
+            appLog->error("Fail to start server on port {}", port);
+            return false;
+        }
+
+        baseline = residentSetSize();
+        appLog->info("Server listening on port {}, slim mode {}, baseline RSS {} kB", port, slim, baseline / 1024);
+
+        clients.setProcessChannelMode(QProcess::ForwardedChannels);
+        clients.start(QCoreApplication::applicationFilePath(),
+            {"--client", "-n", QString::number(count), "-s", QString::number(port)});
+        return true;
+    }
+
+private:
+    void report()
+    {
+        const auto rss = residentSetSize();
+        if(!rss)
+            appLog->warn("Resident set size isn't available on this platform");
+        else
+            appLog->info("RSS {} kB for {} idle clients : {} bytes per connection (slim mode {})", rss / 1024, count,
+                (rss - baseline) / count, slim);
+
+        clients.kill();
+        clients.waitForFinished();
+        QCoreApplication::quit();
+    }
+};
+
+// Open count connections and keep them idle until killed
+class ClientApp
+{
+public:
+    QString ip = QStringLiteral("127.0.0.1");
+    uint16_t port = 9999;
+    int count = 1000;
+
+private:
+    std::vector<std::unique_ptr<QTcpSocket>> sockets;
+
+public:
+    void start()
+    {
+        sockets.reserve(std::size_t(count));
+        for(int i = 0; i < count; ++i)
+        {
+            sockets.emplace_back(new QTcpSocket);
+            sockets.back()->connectToHost(ip, port);
+        }
+    }
+};
+
+static void installLoggers()
+{
+#ifdef _MSC_VER
+    const auto msvcSink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
+    msvcSink->set_level(spdlog::level::debug);
+    appLog->sinks().emplace_back(msvcSink);
+#endif
+
+    // NetTcp logs are not installed, formatting them would weight in the measure
+    const auto stdoutSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    stdoutSink->set_level(spdlog::level::debug);
+    appLog->sinks().emplace_back(stdoutSink);
+}
+
+int main(int argc, char* argv[])
+{
+    installLoggers();
+
+    QCoreApplication app(argc, argv);
+
+    // ────────── COMMAND PARSER ──────────────────────────────────────
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measure memory used per idle connection of a Server");
+    parser.addHelpOption();
+
+    QCommandLineOption portOption(QStringList() << "s"
+                                                << "src",
+        QCoreApplication::translate("main", "Port for server. Default \"9999\"."),
+        QCoreApplication::translate("main", "port"));
+    portOption.setDefaultValue("9999");
+    parser.addOption(portOption);
+
+    QCommandLineOption countOption(QStringList() << "n"
+                                                 << "count",
+        QCoreApplication::translate("main", "Number of idle connections. Default \"1000\"."),
+        QCoreApplication::translate("main", "count"));
+    countOption.setDefaultValue("1000");
+    parser.addOption(countOption);
+
+    QCommandLineOption slimOption(
+        QStringList() << "slim", QCoreApplication::translate("main", "Enable Server slim mode"));
+    parser.addOption(slimOption);
+
+    QCommandLineOption clientOption(QStringList() << "client",
+        QCoreApplication::translate("main", "Only open connections. Used by the benchmark child process"));
+    parser.addOption(clientOption);
+
+    // Process the actual command line arguments given by the user
+    parser.process(app);
+
+    // ────────── APPLICATION ──────────────────────────────────────
+
+    bool ok;
+    auto port = parser.value(portOption).toUShort(&ok);
+    if(!ok)
+        port = 9999;
+    auto count = parser.value(countOption).toInt(&ok);
+    if(!ok || count <= 0)
+        count = 1000;
+
+    ServerApp server;
+    ClientApp client;
+    if(parser.isSet(clientOption))
+    {
+        client.port = port;
+        client.count = count;
+        client.start();
+    }
+    else
+    {
+        server.port = port;
+        server.count = count;
+        server.slim = parser.isSet(slimOption);
+        if(!server.start())
+            return 1;
+    }
+
+    // Start event loop
+    return QCoreApplication::exec();
+}
@@ -1,57 +1,25 @@
 #include <MySocketWorker.hpp>
 
-void MySocketWorker::onConnected()
-{
-    net::tcp::SocketWorker::onConnected();
-    waitingForData = false;
-    bufferLength = 0;
-}
-
 void MySocketWorker::onDataAvailable()
 {
-    // Read header if not done
-    if(!waitingForData)
-        readHeader();
-
-    // Otherwise read maximum number of bytes expected
-    while(waitingForData && bytesAvailable())
+    // Strings are parsed in place in the receive buffer, without copy to a buffer of our own
+    while(bytesAvailable())
     {
-        // Read maximum data until the whole packet have been read.
-        const auto bytesRead = read(buffer + bufferLength, expectedSize - bufferLength);
-        bufferLength += std::uint8_t(bytesRead);
+        const auto view = peek();
 
-        // Emit the received string when read is complete
-        if(bufferLength == expectedSize)
-        {
-            QString s(reinterpret_cast<char*>(buffer));
-            Q_EMIT stringAvailable(s);
-            waitingForData = false;
-            bufferLength = 0;
-            readHeader();
-        }
-    }
-}
+        // Check header is valid
+        const auto size = view[0];
+        if(size == 0 || size >= 128)
+            return closeAndRestart();
 
-void MySocketWorker::readHeader()
-{
-    // Only read if something is available
-    if(!bytesAvailable())
-        return;
+        // Wait for the whole packet
+        if(view.size < std::size_t(1 + size))
+            return;
 
-    // Only read if in correct state
-    if(waitingForData)
-        return;
-
-    // Read 1 byte
-    if(!read(&expectedSize, 1))
-        return closeAndRestart();
-
-    // Check header is valid
-    if(expectedSize == 0 || expectedSize >= 128)
-        return closeAndRestart();
-
-    // Go to next state waiting for data
-    waitingForData = true;
+        // The view stay valid until the next peek, consume before the signal that can close the socket
+        consume(1 + size);
+        Q_EMIT stringAvailable(QString::fromUtf8(view.chars() + 1, int(qstrnlen(view.chars() + 1, size))));
+    }
 }
 
 void MySocketWorker::onSendString(const QString& s)
@@ -0,0 +1,283 @@
+﻿
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Dependencies
+#include <Net/Tcp/NetTcp.hpp>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#ifdef _MSC_VER
+#    include <spdlog/sinks/msvc_sink.h>
+#endif
+
+// Qt
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+// Stl
+#include <algorithm>
+#include <map>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+std::shared_ptr<spdlog::logger> appLog = std::make_shared<spdlog::logger>("app");
+
+/**
+ * Replay a file recorded with ISocket::recordPath / IServer::recordPath over tcp.
+ * - By default connect to ip:port, one tcp connection per recorded connection. Use it to drive a Server.
+ * - With -l, listen on port and wait for a client per recorded connection. Use it to drive a Socket.
+ */
+class App
+{
+public:
+    QString path;
+    QString ip = QStringLiteral("127.0.0.1");
+    uint16_t port = 9999;
+    bool listen = false;
+    bool fast = false;
+    double speed = 1.;
+    net::tcp::TrafficRecorder::Direction direction = net::tcp::TrafficRecorder::Direction::Rx;
+
+private:
+    // Don't buffer the whole file in QTcpSocket when replaying as fast as possible
+    static const qint64 maxBytesToWrite = 4 * 1024 * 1024;
+
+    net::tcp::TrafficReader reader;
+    net::tcp::TrafficReader::Chunk chunk;
+    bool hasChunk = false;
+    std::uint64_t firstTimestamp = 0;
+
+    QTcpServer server;
+    std::map<std::uint32_t, QTcpSocket*> sockets;
+    QTimer pumpTimer;
+    QElapsedTimer clock;
+
+    std::uint64_t chunkCount = 0;
+    std::uint64_t txBytes = 0;
+    std::uint64_t rxBytes = 0;
+    std::uint64_t maxLateUs = 0;
+
+public:
+    bool start()
+    {
+        if(!reader.open(path))
+        {
+            appLog->error("Fail to open record {}", qPrintable(path));
+            return false;
+        }
+
+        if(listen)
+        {
+            if(!server.listen(QHostAddress::Any, port))
+            {
+                appLog->error("Fail to listen on port {} : {}", port, qPrintable(server.errorString()));
+                return false;
+            }
+            QObject::connect(&server, &QTcpServer::newConnection, [this]() { pump(); });
+            appLog->info("Wait for clients on port {}", port);
+        }
+
+        pumpTimer.setSingleShot(true);
+        pumpTimer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&pumpTimer, &QTimer::timeout, [this]() { pump(); });
+
+        hasChunk = nextChunk();
+        firstTimestamp = chunk.timestamp;
+        clock.start();
+        pump();
+        return true;
+    }
+
+private:
+    bool nextChunk()
+    {
+        while(reader.next(chunk))
+        {
+            if(chunk.direction == direction)
+                return true;
+        }
+        return false;
+    }
+
+    QTcpSocket* socketFor(std::uint32_t connection)
+    {
+        const auto it = sockets.find(connection);
+        if(it != sockets.end())
+            return it->second;
+
+        QTcpSocket* socket = nullptr;
+        if(listen)
+        {
+            socket = server.nextPendingConnection();
+            // pump is called again on newConnection
+            if(!socket)
+                return nullptr;
+        }
+        else
+        {
+            socket = new QTcpSocket(&server);
+            socket->connectToHost(ip, port);
+        }
+
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, true);
+        QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() { rxBytes += socket->readAll().size(); });
+        QObject::connect(socket, &QTcpSocket::bytesWritten, [this](qint64) { pump(); });
+        sockets[connection] = socket;
+        appLog->info("Replay connection {}", connection);
+        return socket;
+    }
+
+    void pump()
+    {
+        // Yield to the event loop regularly so sockets can flush and read
+        int budget = 64;
+        while(hasChunk && budget--)
+        {
+            if(!fast)
+            {
+                const auto dueUs = std::uint64_t(double(chunk.timestamp - firstTimestamp) / speed);
+                const auto nowUs = std::uint64_t(clock.nsecsElapsed() / 1000);
+                if(dueUs > nowUs)
+                {
+                    pumpTimer.start(int((dueUs - nowUs) / 1000));
+                    return;
+                }
+                maxLateUs = std::max(maxLateUs, nowUs - dueUs);
+            }
+
+            auto* socket = socketFor(chunk.connection);
+            if(!socket)
+                return;
+
+            if(socket->bytesToWrite() > maxBytesToWrite)
+                return;
+
+            socket->write(chunk.data);
+            txBytes += std::uint64_t(chunk.data.size());
+            ++chunkCount;
+            hasChunk = nextChunk();
+        }
+
+        if(hasChunk)
+            pumpTimer.start(0);
+        else
+            finish();
+    }
+
+    void finish()
+    {
+        if(pumpTimer.isActive() || !clock.isValid())
+            return;
+
+        const auto elapsedMs = std::max<qint64>(clock.elapsed(), 1);
+        appLog->info("Replayed {} chunks, {} bytes on {} connections in {} ms ({:.2f} MB/s). Rx {} bytes. Max late {} us",
+            chunkCount, txBytes, sockets.size(), elapsedMs, double(txBytes) / 1000. / double(elapsedMs), rxBytes,
+            maxLateUs);
+        clock.invalidate();
+
+        for(const auto& it: sockets) it.second->disconnectFromHost();
+        // Give time to flush
+        QTimer::singleShot(1000, []() { QCoreApplication::quit(); });
+    }
+};
+
+static void installLoggers()
+{
+#ifdef _MSC_VER
+    const auto msvcSink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
+    msvcSink->set_level(spdlog::level::debug);
+    net::tcp::Logger::registerSink(msvcSink);
+    appLog->sinks().emplace_back(msvcSink);
+#endif
+
+    const auto stdoutSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    stdoutSink->set_level(spdlog::level::debug);
+    net::tcp::Logger::registerSink(stdoutSink);
+    appLog->sinks().emplace_back(stdoutSink);
+}
+
+int main(int argc, char* argv[])
+{
+    installLoggers();
+
+    QCoreApplication app(argc, argv);
+
+    // ────────── COMMAND PARSER ──────────────────────────────────────
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replay traffic recorded with recordPath");
+    parser.addHelpOption();
+    parser.addPositionalArgument("record", QCoreApplication::translate("main", "Record file to replay"));
+
+    QCommandLineOption portOption(QStringList() << "s"
+                                                << "src",
+        QCoreApplication::translate("main", "Port to connect to, or to listen on. Default \"9999\"."),
+        QCoreApplication::translate("main", "port"));
+    portOption.setDefaultValue("9999");
+    parser.addOption(portOption);
+
+    QCommandLineOption ipOption(QStringList() << "i"
+                                              << "ip",
+        QCoreApplication::translate("main", "Ip address to connect to. Default \"127.0.0.1\""),
+        QCoreApplication::translate("main", "ip"));
+    ipOption.setDefaultValue(QStringLiteral("127.0.0.1"));
+    parser.addOption(ipOption);
+
+    QCommandLineOption listenOption(QStringList() << "l"
+                                                  << "listen",
+        QCoreApplication::translate("main", "Listen for clients instead of connecting to a server"));
+    parser.addOption(listenOption);
+
+    QCommandLineOption txOption(QStringList() << "tx",
+        QCoreApplication::translate("main", "Replay recorded tx chunks instead of rx chunks"));
+    parser.addOption(txOption);
+
+    QCommandLineOption fastOption(QStringList() << "f"
+                                                << "fast",
+        QCoreApplication::translate("main", "Replay as fast as possible instead of original timing"));
+    parser.addOption(fastOption);
+
+    QCommandLineOption speedOption(QStringList() << "speed",
+        QCoreApplication::translate("main", "Speed factor of the original timing. Default \"1\""),
+        QCoreApplication::translate("main", "factor"));
+    speedOption.setDefaultValue("1");
+    parser.addOption(speedOption);
+
+    // Process the actual command line arguments given by the user
+    parser.process(app);
+
+    if(parser.positionalArguments().isEmpty())
+        parser.showHelp(1);
+
+    // ────────── APPLICATION ──────────────────────────────────────
+
+    App replay;
+    replay.path = parser.positionalArguments().first();
+    bool ok;
+    const auto port = parser.value(portOption).toInt(&ok);
+    if(ok)
+        replay.port = port;
+    const auto ip = parser.value(ipOption);
+    if(!ip.isEmpty())
+        replay.ip = ip;
+    const auto speed = parser.value(speedOption).toDouble(&ok);
+    if(ok && speed > 0)
+        replay.speed = speed;
+    replay.listen = parser.isSet(listenOption);
+    replay.fast = parser.isSet(fastOption);
+    if(parser.isSet(txOption))
+        replay.direction = net::tcp::TrafficRecorder::Direction::Tx;
+
+    if(!replay.start())
+        return 1;
+
+    // Start event loop
+    return QCoreApplication::exec();
+}
@@ -0,0 +1,137 @@
+#ifndef __NETTCP_ASYNC_LOG_SINK_HPP__
+#define __NETTCP_ASYNC_LOG_SINK_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Dependencies Headers
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/sinks/sink.h>
+
+// Stl Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Sink that copy log messages into a preallocated lock-free queue,
+ * and forward them to real sinks from one background thread.
+ * Socket worker threads never wait on file or console I/O, except with OverflowPolicy::Block when queue is full.
+ *
+ * The queue is a bounded multi producer multi consumer ring (Dmitry Vyukov design).
+ * Each slot own its message buffer, so no allocation happen for messages that fit in spdlog inline buffer.
+ */
+class NETTCP_API_ AsyncLogSink : public spdlog::sinks::sink
+{
+    // ─────── TYPES ─────────
+public:
+    using SinkPtr = std::shared_ptr<spdlog::sinks::sink>;
+
+    enum class OverflowPolicy
+    {
+        // Wait for the background thread to free a slot. No message is lost.
+        Block,
+        // Discard the oldest queued message to make room.
+        DropOldest,
+        // Discard the message being logged.
+        DropNewest,
+    };
+
+    struct Stats
+    {
+        // Messages accepted in the queue
+        std::uint64_t queued = 0;
+        // Messages forwarded to sinks
+        std::uint64_t processed = 0;
+        std::uint64_t droppedOldest = 0;
+        std::uint64_t droppedNewest = 0;
+        // Number of time a producer had to wait for a free slot
+        std::uint64_t blocked = 0;
+    };
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    // queueSize is rounded up to a power of two
+    AsyncLogSink(std::size_t queueSize, OverflowPolicy policy);
+    ~AsyncLogSink() override;
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    // ─────── SINKS ─────────
+public:
+    void addSink(const SinkPtr& sink);
+    void removeSink(const SinkPtr& sink);
+    std::vector<SinkPtr> sinks() const;
+
+    // ─────── SPDLOG SINK ─────────
+public:
+    void log(const spdlog::details::log_msg& msg) override;
+    // Wait for every message queued before the call to be forwarded, then flush sinks
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    // ─────── API ─────────
+public:
+    OverflowPolicy overflowPolicy() const;
+    std::size_t queueSize() const;
+    Stats stats() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        spdlog::details::log_msg_buffer msg;
+    };
+
+    bool tryPush(const spdlog::details::log_msg& msg);
+    bool tryPop(spdlog::details::log_msg_buffer& msg);
+    bool isEmpty() const;
+    void wakeUpWorker();
+    void run();
+
+private:
+    const OverflowPolicy _policy;
+    const std::size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+
+    std::atomic<std::size_t> _enqueuePos {0};
+    std::atomic<std::size_t> _dequeuePos {0};
+
+    std::atomic<std::uint64_t> _queued {0};
+    std::atomic<std::uint64_t> _processed {0};
+    std::atomic<std::uint64_t> _droppedOldest {0};
+    std::atomic<std::uint64_t> _droppedNewest {0};
+    std::atomic<std::uint64_t> _blocked {0};
+
+    mutable std::mutex _sinksMutex;
+    std::vector<SinkPtr> _sinks;
+
+    std::mutex _wakeUpMutex;
+    std::condition_variable _wakeUp;
+    std::condition_variable _progress;
+    std::atomic<bool> _sleeping {false};
+    // Threads waiting in flush() or for a free slot
+    std::atomic<int> _waiters {0};
+    std::atomic<bool> _running {true};
+    std::thread _thread;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __NETTCP_EVENT_LOOP_MONITOR_HPP__
+#define __NETTCP_EVENT_LOOP_MONITOR_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+#include <Net/Tcp/Property.hpp>
+
+// Qt Headers
+#include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+
+// Stl Headers
+#include <memory>
+
+// ───── DECLARATION ─────
+
+QT_FORWARD_DECLARE_CLASS(QTimer);
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Measure the load of the event loop of the thread this object lives in.
+ * - Every probePeriod ms a probe event is posted, the delay until it is delivered is the scheduling lag.
+ * - Busy/idle time is measured with QAbstractEventDispatcher::aboutToBlock/awake.
+ * - Wakeups are counted on QAbstractEventDispatcher::awake, events processed per wakeup are not counted.
+ * Statistics are published about once per seconds.
+ */
+class NETTCP_API_ EventLoopMonitor : public QObject
+{
+    Q_OBJECT
+    // ──────── CONSTRUCTOR ────────
+public:
+    EventLoopMonitor(QObject* parent = nullptr);
+    ~EventLoopMonitor();
+
+    // ──────── ATTRIBUTE ────────
+protected:
+    // Period in ms between two probe events
+    NETTCP_PROPERTY_D(quint64, probePeriod, ProbePeriod, 100);
+
+    // ──────── STATUS ────────
+protected:
+    // Scheduling lag of the last probe in µs
+    NETTCP_PROPERTY_RO(quint64, lag, Lag);
+    // Max scheduling lag over the last second in µs
+    NETTCP_PROPERTY_RO(quint64, maxLag, MaxLag);
+    // Ratio of time spent processing events over the last second, between 0 and 1
+    NETTCP_PROPERTY_RO(qreal, load, Load);
+    // Number of time the event loop woke up to process events over the last second.
+    // This is not the number of events processed : one wakeup can deliver many events. Qt has no per thread hook
+    // to count delivered events in Qt 5 and Qt 6, application event filters only see the main thread.
+    NETTCP_PROPERTY_RO(quint64, wakeupsPerSeconds, WakeupsPerSeconds);
+
+    // ──────── C++ API ────────
+public Q_SLOTS:
+    // Must be called from the monitored thread
+    void start();
+    void stop();
+
+public:
+    bool isActive() const;
+
+    /**
+     * Started monitor of the calling thread, shared by every Socket and Server of this thread.
+     * It is stopped and destroyed with its last reference, that must be released from this thread.
+     */
+    static std::shared_ptr<EventLoopMonitor> forCurrentThread();
+
+Q_SIGNALS:
+    void statsUpdated(quint64 maxLag, qreal load, quint64 wakeupsPerSeconds);
+
+    // ──────── PRIVATE ────────
+protected:
+    bool event(QEvent* e) override;
+
+private Q_SLOTS:
+    void onProbeTimeout();
+    void onAboutToBlock();
+    void onAwake();
+
+private:
+    void publishStats(qint64 now);
+
+private:
+    QTimer* _probeTimer = nullptr;
+    QElapsedTimer _clock;
+    qint64 _lastProbe = 0;
+    qint64 _windowStart = 0;
+    qint64 _blockedSince = -1;
+    qint64 _idleTime = 0;
+    quint64 _wakeups = 0;
+    quint64 _windowMaxLag = 0;
+};
+
+}
+}
+
+#endif
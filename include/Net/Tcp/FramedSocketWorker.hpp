@@ -0,0 +1,149 @@
+#ifndef __NETTCP_FRAMED_SOCKET_WORKER_HPP__
+#define __NETTCP_FRAMED_SOCKET_WORKER_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/SocketWorker.hpp>
+#include <Net/Tcp/SendScheduler.hpp>
+
+// Qt Headers
+#include <QtCore/QByteArray>
+
+// Stl Headers
+#include <array>
+#include <atomic>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Worker that exchange length prefixed messages instead of a byte stream.
+ * Each frame start with a 32 bits big endian header : payload length in the low 28 bits,
+ * and flags in the top 4 bits (see FrameFlag).
+ * Messages are sent through priority lanes of a SendScheduler, and big messages are split in frames of chunkSize
+ * bytes, so messages of a higher priority lane are written between two frames of a bulk message.
+ * The peer reassemble them, and onFrameReceived is called with whole messages.
+ */
+class NETTCP_API_ FramedSocketWorker : public SocketWorker
+{
+    Q_OBJECT
+    // ──────── CONSTRUCTOR ────────
+public:
+    FramedSocketWorker(QObject* parent = nullptr);
+
+    // ──────── FRAME HEADER ────────
+public:
+    static const int headerSize = 4;
+    static const quint32 maxPayloadSize = 0x0FFFFFFF;
+    static const int flagsShift = 28;
+    static const int laneCount = 4;
+
+    enum FrameFlag : quint8
+    {
+        // Lane of the message the frame belongs to
+        LaneMask = 0x3,
+        // More frames of the same message follow
+        More = 0x4,
+        // Frame used by NetTcp itself, not part of a message
+        Control = 0x8,
+    };
+
+    static quint32 encodeHeader(quint32 payloadSize, quint8 flags = 0);
+    static quint32 headerPayloadSize(quint32 header) { return header & maxPayloadSize; }
+    static quint8 headerFlags(quint32 header) { return quint8(header >> flagsShift); }
+
+    // ──────── WRITE API ────────
+public:
+    /**
+     * Queue a message in lane, 0 being the highest priority, and write it from the worker thread.
+     * Thread safe. The message is dropped if the socket isn't connected when it's written.
+     * A message bigger than the peer maxFrameSize close the connection.
+     */
+    void sendFrame(const QByteArray& payload, int lane = 0);
+    // Lanes and chunk size of outgoing messages. Thread safe
+    SendScheduler& sendScheduler() { return _sendScheduler; }
+
+public Q_SLOTS:
+    /**
+     * Queue a message in lane and write what the socket can take. Call from the worker thread.
+     * Return false if the socket isn't connected, or payload is bigger than maxFrameSize.
+     */
+    bool writeFrame(const QByteArray& payload, int lane = 0);
+    // Messages bigger than this in bytes close the connection. 16 MB by default
+    void setMaxFrameSize(quint32 value);
+    /**
+     * Data given to Socket::send or Server::broadcast is one message in lane 0.
+     * It is dropped if the socket isn't connected : the outbound queue track raw bytes and isn't used.
+     */
+    void onSendData(const QByteArray& data) override;
+
+protected:
+    // Messages given to Socket::sendConflated are framed too
+    bool writeMessage(const QByteArray& message) override;
+    // Messages held by the scheduler count as waiting bytes
+    bool isCongested() const override;
+    // Write a control frame immediately, before queued messages
+    bool writeControlFrame(const QByteArray& payload);
+    // Heartbeats are control frames
+    bool writeHeartbeat(const QByteArray& heartbeat) override;
+    void onWriteProgress(qint64 bytes) override;
+
+private:
+    // Write chunks while the socket buffer hold less than one chunk, so a new message never wait for more
+    void pumpSendScheduler();
+    void dropQueuedMessages();
+
+private:
+    SendScheduler _sendScheduler {laneCount};
+    // A pump is already posted to the worker thread
+    std::atomic<bool> _pumpPending {false};
+
+    // ──────── READ API ────────
+protected:
+    void onDataAvailable() override;
+    void onConnected() override;
+    void onDisconnected() override;
+
+    /**
+     * Complete message. Default implementation emit frameReceived.
+     * A message of one frame up to maxInPlacePayloadSize bytes is parsed in place : payload point into the receive
+     * buffer and is only valid during the call. Copy it with QByteArray(payload.constData(), payload.size()) to keep it
+     */
+    virtual void onFrameReceived(const QByteArray& payload);
+    // Complete control frame, parsed in place like onFrameReceived. Default implementation handle heartbeats
+    // and drop other frames
+    virtual void onControlFrameReceived(const QByteArray& payload);
+
+Q_SIGNALS:
+    void frameReceived(const QByteArray& payload);
+
+private:
+    // Return false if the connection was closed. inPlace if payload point into the receive buffer
+    bool onFrame(quint8 flags, QByteArray payload, bool inPlace);
+    void resetFrame();
+
+protected:
+    // Bigger payloads are read in their own buffer instead of growing the receive buffer to their size
+    static const quint32 maxInPlacePayloadSize = 64 * 1024;
+
+private:
+    quint32 _maxFrameSize = 16 * 1024 * 1024;
+    // Flags and payload of the big frame being read
+    quint8 _frameFlags = 0;
+    QByteArray _payload;
+    int _payloadRead = 0;
+    // The message given to onFrameReceived point into the receive buffer
+    bool _payloadInPlace = false;
+    // Messages being reassembled, per lane
+    std::array<QByteArray, laneCount> _partialMessages;
+};
+
+}
+}
+
+#endif
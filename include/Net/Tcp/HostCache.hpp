@@ -0,0 +1,74 @@
+#ifndef __NETTCP_HOST_CACHE_HPP__
+#define __NETTCP_HOST_CACHE_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtNetwork/QHostAddress>
+
+// Stl Headers
+#include <chrono>
+#include <mutex>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Resolved addresses of host names, shared by every Socket of the process.
+ * Reconnection attempts don't resolve the host again until the entry is older than ttl.
+ * Thread safe.
+ */
+class NETTCP_API_ HostCache
+{
+    // ─────── CONSTRUCTOR ─────────
+public:
+    static HostCache& instance();
+
+    HostCache(const HostCache&) = delete;
+    HostCache& operator=(const HostCache&) = delete;
+
+private:
+    HostCache() = default;
+
+    // ─────── API ─────────
+public:
+    // Time to live of entries in ms, 60 s by default. 0 disables the cache
+    void setTtl(int ttl);
+    int ttl() const;
+
+    // Fill addresses and return true if host has a valid entry
+    bool lookup(const QString& host, QList<QHostAddress>& addresses);
+    // Empty addresses are ignored, a failed resolution is retried next time
+    void insert(const QString& host, const QList<QHostAddress>& addresses);
+    void remove(const QString& host);
+    void clear();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        QList<QHostAddress> addresses;
+        Clock::time_point expiry;
+    };
+
+private:
+    mutable std::mutex _mutex;
+    int _ttl = 60000;
+    QHash<QString, Entry> _entries;
+};
+
+}
+}
+
+#endif
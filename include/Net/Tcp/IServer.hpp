@@ -9,6 +9,9 @@
 // Dependencies Headers
 #include <QOlm/QOlm.hpp>
 
+// Qt Headers
+#include <QtCore/QVariantMap>
+
 // ───── DECLARATION ─────
 
 namespace net {
@@ -37,10 +40,62 @@ protected:
     NETTCP_PROPERTY(quint16, port, Port);
     NETTCP_PROPERTY(bool, useWorkerThread, UseWorkerThread);
     NETTCP_PROPERTY_D(bool, noDelay, NoDelay, true);
+    // Kernel options forwarded to every client. See ISocket::receiveBufferSize
+    NETTCP_PROPERTY(int, receiveBufferSize, ReceiveBufferSize);
+    NETTCP_PROPERTY(int, sendBufferSize, SendBufferSize);
+    NETTCP_PROPERTY(int, keepAliveIdle, KeepAliveIdle);
+    NETTCP_PROPERTY(int, keepAliveInterval, KeepAliveInterval);
+    NETTCP_PROPERTY(int, keepAliveCount, KeepAliveCount);
+    NETTCP_PROPERTY(int, userTimeout, UserTimeout);
+    NETTCP_PROPERTY(bool, quickAck, QuickAck);
+    NETTCP_PROPERTY(int, notSentLowWatermark, NotSentLowWatermark);
+    NETTCP_PROPERTY(int, typeOfService, TypeOfService);
+    NETTCP_PROPERTY(int, socketPriority, SocketPriority);
+    // Forwarded to every client. See ISocket::readLowWatermark
+    NETTCP_PROPERTY(int, readLowWatermark, ReadLowWatermark);
+    NETTCP_PROPERTY_D(quint64, readMaxDelay, ReadMaxDelay, 1);
+    // Forwarded to every client, for fairness between clients sharing a thread. See ISocket::readBudget
+    NETTCP_PROPERTY(quint64, readBudget, ReadBudget);
 
     // Max count of clients that are allowed
     NETTCP_PROPERTY_D(int, maxClientCount, MaxClientCount, 32);
 
+    // Measure the load of the server event loop, and of every client worker event loop. See EventLoopMonitor
+    NETTCP_PROPERTY(bool, monitorEventLoop, MonitorEventLoop);
+    // Refuse new clients while the server event loop lag is above this value in µs. 0 to disable.
+    // Only used when monitorEventLoop is true
+    NETTCP_PROPERTY(quint64, maxEventLoopLag, MaxEventLoopLag);
+    // Sample kernel TCP_INFO of every client every tcpInfoPeriod ms. 0 to disable. See ISocket::tcpInfoPeriod
+    NETTCP_PROPERTY(quint64, tcpInfoPeriod, TcpInfoPeriod);
+    // Record traffic of every client to this file. Empty to disable. See ISocket::recordPath
+    NETTCP_PROPERTY(QString, recordPath, RecordPath);
+    // Reduce the fixed cost of each client for servers with many mostly idle clients : clients live in the server
+    // thread, so there is no QThread per client (useWorkerThread is ignored), and use ISocket::slimMode.
+    // A Socket, a SocketWorker and a QTcpSocket are still allocated per client
+    NETTCP_PROPERTY(bool, slimMode, SlimMode);
+    // Forwarded to every client. See ISocket::idleTimeout
+    NETTCP_PROPERTY(quint64, idleTimeout, IdleTimeout);
+    // Forwarded to every client. See ISocket::heartbeatPeriod
+    NETTCP_PROPERTY(quint64, heartbeatPeriod, HeartbeatPeriod);
+    NETTCP_PROPERTY_D(int, heartbeatMaxMissed, HeartbeatMaxMissed, 3);
+    // Bytes per seconds read from, and written to, all clients together. 0 for no limit.
+    // Clients also apply their own ISocket::rxRateLimit and ISocket::txRateLimit
+    NETTCP_PROPERTY(quint64, rxRateLimit, RxRateLimit);
+    NETTCP_PROPERTY(quint64, txRateLimit, TxRateLimit);
+    // Count of idle sockets kept prepared (worker created, threaded and connected) to accept new clients,
+    // and to recycle disconnected clients into instead of destroying them. 0 to disable.
+    NETTCP_PROPERTY(int, socketPoolSize, SocketPoolSize);
+
+    // ──────── STATUS ────────
+protected:
+    // Only updated when monitorEventLoop is true
+    // Max scheduling lag of the server event loop over the last second in µs
+    NETTCP_PROPERTY_RO(quint64, eventLoopLag, EventLoopLag);
+    // Ratio of time the server event loop is busy, between 0 and 1
+    NETTCP_PROPERTY_RO(qreal, eventLoopLoad, EventLoopLoad);
+    // Number of time the server event loop woke up over the last second, not the number of events processed
+    NETTCP_PROPERTY_RO(quint64, eventLoopWakeupsPerSeconds, EventLoopWakeupsPerSeconds);
+
     // ──────── C++ API ────────
 public Q_SLOTS:
     virtual bool start() = 0;
@@ -54,6 +109,12 @@ public Q_SLOTS:
     virtual void disconnectFrom(const QString& address, const quint16 port) = 0;
     virtual void disconnectFrom(const QString& address) = 0;
 
+    /**
+     * Percentiles of TCP_INFO values across connected clients, when tcpInfoPeriod isn't 0.
+     * { "count": N, "rtt": { "p50", "p90", "p99", "max", "maxPeer" }, "rttVariance": {...}, ... }
+     */
+    virtual QVariantMap tcpInfoSummary() const = 0;
+
     // ──────── SIGNALS ────────
 Q_SIGNALS:
     void acceptError(int error, const QString description);
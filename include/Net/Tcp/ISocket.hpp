@@ -7,6 +7,9 @@
 #include <Net/Tcp/Export.hpp>
 #include <Net/Tcp/Property.hpp>
 
+// Qt Headers
+#include <QtCore/QVariantMap>
+
 // ───── DECLARATION ─────
 
 namespace net {
@@ -26,6 +29,37 @@ protected:
     NETTCP_PROPERTY_RO(bool, isRunning, Running);
     NETTCP_PROPERTY_RO(bool, isConnected, Connected);
     NETTCP_PROPERTY_D(quint64, watchdogPeriod, WatchdogPeriod, 5000);
+    // Reconnection delay start at watchdogPeriod, and is multiplied by reconnectMultiplier after each failed attempt,
+    // up to reconnectMaxDelay ms (0 for no limit). It is reset once connected. See ReconnectPolicy
+    NETTCP_PROPERTY_D(qreal, reconnectMultiplier, ReconnectMultiplier, 1.);
+    NETTCP_PROPERTY(quint64, reconnectMaxDelay, ReconnectMaxDelay);
+    // ReconnectPolicy::Jitter : 0 None, 1 Full, 2 Decorrelated
+    NETTCP_PROPERTY(int, reconnectJitter, ReconnectJitter);
+    // Abort a connection attempt that isn't connected after connectTimeout ms, and retry. 0 for the system timeout
+    NETTCP_PROPERTY(quint64, connectTimeout, ConnectTimeout);
+    // When the peer resolve to several addresses, try the next one in parallel if the current one doesn't answer
+    // after connectAttemptDelay ms. 0 to only try the next address when the current one fail. See HostCache
+    // connectTimeout and connectAttemptDelay run on the TimerWheel of the worker thread. They are counted in whole
+    // 100 ms ticks and the current tick is already started : 250 ms fire after 200 to 300 ms
+    NETTCP_PROPERTY_D(quint64, connectAttemptDelay, ConnectAttemptDelay, 250);
+    // Keep data given to Socket::send while disconnected, and data not yet written to the kernel when the connection
+    // is lost, up to outboundQueueSize bytes. Queued data is written in one batch once reconnected. 0 to disable.
+    // Not used by FramedSocketWorker, that drop messages with the connection
+    NETTCP_PROPERTY(quint64, outboundQueueSize, OutboundQueueSize);
+    // Drop queued data older than outboundQueueMaxAge ms. 0 for no limit
+    NETTCP_PROPERTY(quint64, outboundQueueMaxAge, OutboundQueueMaxAge);
+    // When the outbound queue is full : 0 drop oldest data, 1 drop newest data
+    NETTCP_PROPERTY(int, outboundQueueDropPolicy, OutboundQueueDropPolicy);
+    // Socket::sendConflated hold data while more than conflationThreshold bytes wait to be written to the kernel.
+    // Held data is replaced by newer data of the same key, and written once the socket is writable again
+    NETTCP_PROPERTY_D(quint64, conflationThreshold, ConflationThreshold, 65536);
+    // Max count of keys held by the conflation queue, data of other keys is dropped. 0 for no limit
+    NETTCP_PROPERTY(int, conflationMaxKeys, ConflationMaxKeys);
+    // Bytes per seconds read from the socket, 0 for no limit. Reading pause when the limit is reached, and the
+    // socket read buffer is capped so the peer is slowed down by TCP flow control. See TokenBucket
+    NETTCP_PROPERTY(quint64, rxRateLimit, RxRateLimit);
+    // Bytes per seconds written to the kernel, 0 for no limit. Bytes above the limit are paced by the worker
+    NETTCP_PROPERTY(quint64, txRateLimit, TxRateLimit);
 
     // ──────── ATTRIBUTE ────────
 protected:
@@ -36,6 +70,44 @@ protected:
     NETTCP_PROPERTY(quintptr, socketDescriptor, SocketDescriptor);
     NETTCP_PROPERTY(bool, useWorkerThread, UseWorkerThread);
     NETTCP_PROPERTY_D(bool, noDelay, NoDelay, true);
+    // Kernel options applied on every connection, and again when changed. 0 (or false) leave the system value,
+    // keepalive, userTimeout and quickAck set back to 0 restore it. See SocketOptions for units and platform support
+    NETTCP_PROPERTY(int, receiveBufferSize, ReceiveBufferSize);
+    NETTCP_PROPERTY(int, sendBufferSize, SendBufferSize);
+    NETTCP_PROPERTY(int, keepAliveIdle, KeepAliveIdle);
+    NETTCP_PROPERTY(int, keepAliveInterval, KeepAliveInterval);
+    NETTCP_PROPERTY(int, keepAliveCount, KeepAliveCount);
+    NETTCP_PROPERTY(int, userTimeout, UserTimeout);
+    NETTCP_PROPERTY(bool, quickAck, QuickAck);
+    NETTCP_PROPERTY(int, notSentLowWatermark, NotSentLowWatermark);
+    NETTCP_PROPERTY(int, typeOfService, TypeOfService);
+    NETTCP_PROPERTY(int, socketPriority, SocketPriority);
+    // Coalesce readyRead : the kernel only wake the worker once readLowWatermark bytes are received (SO_RCVLOWAT),
+    // so onDataAvailable see fewer and bigger batches. Bytes below the watermark are read after readMaxDelay to
+    // 2 readMaxDelay ms without read, 0 to wait for more bytes. 0 to disable. Only supported on Linux
+    NETTCP_PROPERTY(int, readLowWatermark, ReadLowWatermark);
+    NETTCP_PROPERTY_D(quint64, readMaxDelay, ReadMaxDelay, 1);
+    // Max bytes read by one onDataAvailable call, 0 for no limit. The rest is read on the next event loop iteration,
+    // after the other sockets of the thread, so a busy peer can't starve them
+    NETTCP_PROPERTY(quint64, readBudget, ReadBudget);
+    // Measure the load of the event loop the worker live in. One EventLoopMonitor is shared by every socket of a thread
+    NETTCP_PROPERTY(bool, monitorEventLoop, MonitorEventLoop);
+    // Sample kernel TCP_INFO every tcpInfoPeriod ms while connected. 0 to disable. Only supported on Linux.
+    NETTCP_PROPERTY(quint64, tcpInfoPeriod, TcpInfoPeriod);
+    // Record every chunk read/written by the worker to this file. Empty to disable. See TrafficRecorder
+    NETTCP_PROPERTY(QString, recordPath, RecordPath);
+    // Don't build object names, and run the bytes counter on the thread TimerWheel instead of a QTimer per connection
+    NETTCP_PROPERTY(bool, slimMode, SlimMode);
+    // Park the connection after idleTimeout ms without traffic : stop the bytes counter and release worker buffers.
+    // It wakes up on the next read or write. 0 to disable.
+    NETTCP_PROPERTY(quint64, idleTimeout, IdleTimeout);
+    // Send a ping every heartbeatPeriod ms while connected, to measure the round trip and detect a dead peer
+    // long before the system does. 0 to disable. Needs a worker that can send them out of band of the data,
+    // like FramedSocketWorker. Heartbeats aren't traffic for idleTimeout :
+    // a connection exchanging only heartbeats is still parked
+    NETTCP_PROPERTY(quint64, heartbeatPeriod, HeartbeatPeriod);
+    // Close the connection after heartbeatMaxMissed pings without answer. 0 to only measure the round trip
+    NETTCP_PROPERTY_D(int, heartbeatMaxMissed, HeartbeatMaxMissed, 3);
 
     // ──────── STATUS ────────
 protected:
@@ -44,6 +116,51 @@ protected:
     NETTCP_PROPERTY_RO(quint64, rxBytesTotal, RxBytesTotal);
     NETTCP_PROPERTY_RO(quint64, txBytesTotal, TxBytesTotal);
 
+    // Only updated when idleTimeout isn't 0
+    NETTCP_PROPERTY_RO(bool, isIdle, Idle);
+    // Bytes released by SocketWorker::releaseIdleBuffers since the socket was created
+    NETTCP_PROPERTY_RO(quint64, idleReclaimedBytes, IdleReclaimedBytes);
+    // Messages dropped by the outbound queue because it was full or they expired
+    NETTCP_PROPERTY_RO(quint64, outboundDroppedCount, OutboundDroppedCount);
+    // Data given to sendConflated and replaced by newer data of the same key before being written.
+    // Updated every second
+    NETTCP_PROPERTY_RO(quint64, conflatedCount, ConflatedCount);
+    // Data given to sendConflated and dropped : disconnected, conflationMaxKeys reached, or connection lost
+    NETTCP_PROPERTY_RO(quint64, conflationDroppedCount, ConflationDroppedCount);
+    // Reading is paused by rxRateLimit, or by the rxRateLimit of the Server
+    NETTCP_PROPERTY_RO(bool, rxThrottled, RxThrottled);
+    // Written bytes wait for txRateLimit, or for the txRateLimit of the Server
+    NETTCP_PROPERTY_RO(bool, txThrottled, TxThrottled);
+    // onDataAvailable calls cut by readBudget
+    NETTCP_PROPERTY_RO(quint64, readBudgetExceededCount, ReadBudgetExceededCount);
+    // Longest onDataAvailable call over the last second in µs, that delay other sockets of the thread
+    NETTCP_PROPERTY_RO(quint64, readDispatchTimeMax, ReadDispatchTimeMax);
+    // Longest wait of a read cut by readBudget for its turn over the last second in µs
+    NETTCP_PROPERTY_RO(quint64, readRequeueLatencyMax, ReadRequeueLatencyMax);
+
+    // Only updated when monitorEventLoop is true
+    // Max scheduling lag of the worker event loop over the last second in µs
+    NETTCP_PROPERTY_RO(quint64, eventLoopLag, EventLoopLag);
+    // Ratio of time the worker event loop is busy, between 0 and 1
+    NETTCP_PROPERTY_RO(qreal, eventLoopLoad, EventLoopLoad);
+    // Number of time the worker event loop woke up over the last second, not the number of events processed
+    NETTCP_PROPERTY_RO(quint64, eventLoopWakeupsPerSeconds, EventLoopWakeupsPerSeconds);
+
+    // Options used by the kernel, read back once applied. Keys are the option properties names
+    NETTCP_PROPERTY_RO(QVariantMap, effectiveSocketOptions, EffectiveSocketOptions);
+
+    // Only updated when heartbeatPeriod isn't 0. Smoothed round trip of heartbeats, and its mean deviation, in µs
+    NETTCP_PROPERTY_RO(quint64, heartbeatRtt, HeartbeatRtt);
+    NETTCP_PROPERTY_RO(quint64, heartbeatJitter, HeartbeatJitter);
+
+    // Only updated when tcpInfoPeriod isn't 0. See TcpInfo
+    NETTCP_PROPERTY_RO(quint32, tcpRtt, TcpRtt);
+    NETTCP_PROPERTY_RO(quint32, tcpRttVariance, TcpRttVariance);
+    NETTCP_PROPERTY_RO(quint32, tcpCongestionWindow, TcpCongestionWindow);
+    NETTCP_PROPERTY_RO(quint32, tcpRetransmits, TcpRetransmits);
+    NETTCP_PROPERTY_RO(quint32, tcpUnackedSegments, TcpUnackedSegments);
+    NETTCP_PROPERTY_RO(quint32, tcpSendQueueBytes, TcpSendQueueBytes);
+
     // ──────── C++ API ────────
 public Q_SLOTS:
     virtual bool start() = 0;
@@ -5,17 +5,80 @@
 
 // Library Headers
 #include <Net/Tcp/Export.hpp>
+#include <Net/Tcp/AsyncLogSink.hpp>
 
 // Dependencies Headerss
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/sink.h>
 
 // Stl Headers
+#include <cstdint>
 #include <memory>
 #include <set>
+#include <string>
 
 // ───── DECLARATION ─────
 
+// Minimum level compiled in the library, as spdlog::level::level_enum value
+// (0 trace, 1 debug, 2 info, 3 warn, 4 err, 5 critical, 6 off).
+// Logs below this level are removed with the evaluation of their arguments.
+#ifndef NETTCP_LOG_LEVEL
+#    define NETTCP_LOG_LEVEL 0
+#endif
+
+// Per logger minimum level, default to NETTCP_LOG_LEVEL
+#ifndef NETTCP_SERVER_LOG_LEVEL
+#    define NETTCP_SERVER_LOG_LEVEL NETTCP_LOG_LEVEL
+#endif
+#ifndef NETTCP_SOCKET_LOG_LEVEL
+#    define NETTCP_SOCKET_LOG_LEVEL NETTCP_LOG_LEVEL
+#endif
+#ifndef NETTCP_SOCKET_WORKER_LOG_LEVEL
+#    define NETTCP_SOCKET_WORKER_LOG_LEVEL NETTCP_LOG_LEVEL
+#endif
+#ifndef NETTCP_UTILS_LOG_LEVEL
+#    define NETTCP_UTILS_LOG_LEVEL NETTCP_LOG_LEVEL
+#endif
+
+/**
+ * Log only if level is compiled (compileLevel) and enabled at runtime on logger.
+ * Arguments are evaluated only when the message is going to be formatted,
+ * so peer address or error string conversion cost nothing when the level is off.
+ */
+#define NETTCP_LOG(logger, compileLevel, level, ...)                       \
+    do                                                                     \
+    {                                                                      \
+        if(int(level) >= int(compileLevel) && (logger)->should_log(level)) \
+            (logger)->log(level, __VA_ARGS__);                             \
+    } while(0)
+
+/**
+ * Like NETTCP_LOG, but collapse repeated messages from the same call site (str) for the same object.
+ * Only the first message of each Logger::throttlePeriod() window reach the sinks,
+ * the others are counted and summarized by one "suppressed N times" line, that carry the last of them.
+ * Arguments are not part of the key: use NETTCP_LOG_THROTTLED_BY when they matter.
+ * Call Logger::forgetThrottled(object) when object stop, its address might be reused by another one.
+ */
+#define NETTCP_LOG_THROTTLED(logger, compileLevel, level, object, str, ...) \
+    NETTCP_LOG_THROTTLED_BY(logger, compileLevel, level, object, 0, str, ##__VA_ARGS__)
+
+/**
+ * Like NETTCP_LOG_THROTTLED, with variant (an integer like a socket state or an error code) added to the key.
+ * Messages with different variants are throttled independently, so a new state or error is always logged.
+ */
+#define NETTCP_LOG_THROTTLED_BY(logger, compileLevel, level, object, variant, str, ...)              \
+    do                                                                                               \
+    {                                                                                                \
+        if(int(level) >= int(compileLevel) && (logger)->should_log(level))                           \
+        {                                                                                            \
+            if(net::tcp::Logger::throttle((logger).get(), str, object, level, std::uint64_t(variant))) \
+                (logger)->log(level, str, ##__VA_ARGS__);                                            \
+            else                                                                                     \
+                net::tcp::Logger::setSuppressedMessage((logger).get(), str, object,                  \
+                    std::uint64_t(variant), fmt::format(str, ##__VA_ARGS__));                        \
+        }                                                                                            \
+    } while(0)
+
 namespace net {
 namespace tcp {
 
@@ -34,6 +97,20 @@ public:
     using LogList = std::set<LogPtr>;
     using Sink = spdlog::sinks::sink;
     using SinkPtr = std::shared_ptr<Sink>;
+    using OverflowPolicy = AsyncLogSink::OverflowPolicy;
+    using AsyncStats = AsyncLogSink::Stats;
+
+    struct ThrottleStats
+    {
+        // Messages let through by throttle()
+        std::uint64_t logged = 0;
+        // Messages collapsed in a summary
+        std::uint64_t suppressed = 0;
+        // Summary lines emitted
+        std::uint64_t summaries = 0;
+        // (logger, call site, object, variant) currently tracked
+        std::size_t keys = 0;
+    };
 
     // ─────── LOGGERS NAME ─────────
 public:
@@ -56,6 +133,47 @@ public:
 public:
     static void registerSink(const SinkPtr& sink);
     static void unRegisterSink(const SinkPtr& sink);
+
+    // ─────── ASYNC ─────────
+public:
+    /**
+     * Forward logs to registered sinks from one background thread, through a preallocated queue of queueSize messages.
+     * Sink I/O then never run on socket worker threads.
+     * Call it before starting sockets, like registerSink.
+     */
+    static void enableAsync(std::size_t queueSize = 8192, OverflowPolicy policy = OverflowPolicy::Block);
+    // Flush pending messages, stop the background thread, and log synchronously again
+    static void disableAsync();
+    static bool isAsync();
+    // Counters since enableAsync. Zeroed when async is disabled
+    static AsyncStats asyncStats();
+    // Block until every message logged before the call reached the sinks
+    static void flush();
+
+    // ─────── THROTTLE ─────────
+public:
+    /**
+     * Return true if a message from site (format string) about object should be logged now.
+     * Otherwise the message is counted, and reported by a summary line when its window expire.
+     * variant split one site in independent keys.
+     * Used by NETTCP_LOG_THROTTLED. Thread safe, keys are sharded so concurrent callers rarely contend.
+     */
+    static bool throttle(Log* log,
+        const char* site,
+        const void* object,
+        spdlog::level::level_enum level,
+        std::uint64_t variant = 0);
+    // Keep message as the last suppressed one of its key, printed by the summary
+    static void setSuppressedMessage(
+        Log* log, const char* site, const void* object, std::uint64_t variant, std::string message);
+    // Summarize and forget every key of object, so an object reusing its address start without suppressed messages
+    static void forgetThrottled(const void* object);
+    // Window in ms during which repeated messages are collapsed. 0 disable throttling. Default 1000.
+    static void setThrottlePeriod(int period);
+    static int throttlePeriod();
+    static ThrottleStats throttleStats();
+    // Emit summary of every pending suppressed messages now
+    static void flushThrottled();
 };
 
 }
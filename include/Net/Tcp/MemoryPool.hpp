@@ -0,0 +1,164 @@
+#ifndef __NETTCP_MEMORY_POOL_HPP__
+#define __NETTCP_MEMORY_POOL_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Stl Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Size classed free lists (64 B to 64 KB, power of two) for per connection objects and buffers.
+ * Freed blocks are kept to be reused by the next connection instead of going back to the global allocator.
+ *
+ * Each thread has a small lock-free cache per size class, backed by a shared depot protected by one mutex per class.
+ * Memory can be freed from another thread than the one that allocated it.
+ * Bigger allocations go straight to the global allocator.
+ */
+class NETTCP_API_ MemoryPool
+{
+    // ─────── TYPES ─────────
+public:
+    static const std::size_t minBlockSize = 64;
+    static const std::size_t maxBlockSize = 64 * 1024;
+    static const std::size_t classCount = 11;
+
+    struct Stats
+    {
+        // Allocations served from a free list
+        std::uint64_t hits = 0;
+        // Allocations that needed a new block from the global allocator
+        std::uint64_t misses = 0;
+        // Allocations bigger than maxBlockSize
+        std::uint64_t oversized = 0;
+        // Bytes kept in free lists
+        std::uint64_t cachedBytes = 0;
+    };
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    // Never destroyed, so objects can be freed during static destruction
+    static MemoryPool& instance();
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+private:
+    MemoryPool() = default;
+
+    // ─────── API ─────────
+public:
+    void* allocate(std::size_t size);
+    // size must be the one given to allocate
+    void deallocate(void* p, std::size_t size);
+
+    // Size of the block really allocated for size
+    static std::size_t blockSize(std::size_t size);
+
+    Stats stats() const;
+
+    // Bytes each size class keeps in the shared depot before releasing blocks to the global allocator
+    void setMaxCachedBytesPerClass(std::size_t bytes);
+    std::size_t maxCachedBytesPerClass() const;
+
+    // Release every block of the shared depot to the global allocator
+    void trim();
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    struct Depot
+    {
+        std::mutex mutex;
+        Block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    struct ThreadCache;
+    // nullptr once the cache of the calling thread is destroyed
+    static ThreadCache* threadCache();
+
+    static std::size_t classOf(std::size_t size);
+    // Move up to count blocks from depot to list. Return the number of moved blocks
+    std::size_t takeFromDepot(std::size_t sizeClass, Block*& list, std::size_t count);
+    void giveToDepot(std::size_t sizeClass, Block* list);
+
+private:
+    Depot _depots[classCount];
+    std::atomic<std::size_t> _maxCachedBytesPerClass {4 * 1024 * 1024};
+
+    std::atomic<std::uint64_t> _hits {0};
+    std::atomic<std::uint64_t> _misses {0};
+    std::atomic<std::uint64_t> _oversized {0};
+    std::atomic<std::int64_t> _cachedBytes {0};
+};
+
+/**
+ * Add to a class to allocate its objects, and objects of derived classes, from MemoryPool. Leave a public section.
+ * Don't use on types created by the QML engine, that allocate memory itself and construct in place.
+ */
+#define NETTCP_POOL_ALLOCATED                                                                                \
+public:                                                                                                      \
+    static void* operator new(std::size_t size) { return net::tcp::MemoryPool::instance().allocate(size); } \
+    static void operator delete(void* p, std::size_t size)                                                   \
+    {                                                                                                        \
+        net::tcp::MemoryPool::instance().deallocate(p, size);                                                \
+    }
+
+/**
+ * Byte buffer whose storage come from MemoryPool, so read/write buffers are recycled between connections.
+ * Capacity only grows by reserve(), and is given back to the pool by release() or destruction.
+ */
+class NETTCP_API_ PooledBuffer
+{
+public:
+    PooledBuffer() = default;
+    explicit PooledBuffer(std::size_t capacity);
+    ~PooledBuffer();
+
+    PooledBuffer(PooledBuffer&& other) noexcept;
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+public:
+    std::uint8_t* data() { return _data; }
+    const std::uint8_t* data() const { return _data; }
+    std::size_t size() const { return _size; }
+    std::size_t capacity() const { return _capacity; }
+    bool isEmpty() const { return _size == 0; }
+
+    // Keep the first size bytes when growing
+    void reserve(std::size_t capacity);
+    // Reserve if needed. New bytes are uninitialized
+    void resize(std::size_t size);
+    void append(const void* data, std::size_t length);
+    void clear() { _size = 0; }
+    // Give storage back to the pool
+    void release();
+
+private:
+    std::uint8_t* _data = nullptr;
+    std::size_t _size = 0;
+    std::size_t _capacity = 0;
+};
+
+}
+}
+
+#endif
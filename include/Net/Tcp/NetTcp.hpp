@@ -9,10 +9,29 @@
 #include <Net/Tcp/Version.hpp>
 #include <Net/Tcp/Utils.hpp>
 #include <Net/Tcp/Logger.hpp>
+#include <Net/Tcp/AsyncLogSink.hpp>
+#include <Net/Tcp/Trace.hpp>
+#include <Net/Tcp/MemoryPool.hpp>
+#include <Net/Tcp/ReceiveBuffer.hpp>
 
 // Library code
 #include <Net/Tcp/Server.hpp>
 #include <Net/Tcp/Socket.hpp>
 #include <Net/Tcp/SocketWorker.hpp>
+#include <Net/Tcp/SocketPool.hpp>
+#include <Net/Tcp/EventLoopMonitor.hpp>
+#include <Net/Tcp/TcpInfo.hpp>
+#include <Net/Tcp/SocketOptions.hpp>
+#include <Net/Tcp/TrafficRecorder.hpp>
+#include <Net/Tcp/TimerWheel.hpp>
+#include <Net/Tcp/ReconnectPolicy.hpp>
+#include <Net/Tcp/ReconnectScheduler.hpp>
+#include <Net/Tcp/HostCache.hpp>
+#include <Net/Tcp/SendScheduler.hpp>
+#include <Net/Tcp/TokenBucket.hpp>
+#include <Net/Tcp/FramedSocketWorker.hpp>
+#include <Net/Tcp/RpcReply.hpp>
+#include <Net/Tcp/RpcSocketWorker.hpp>
+#include <Net/Tcp/RpcSocket.hpp>
 
 #endif
@@ -0,0 +1,66 @@
+#ifndef __NETTCP_RECEIVE_BUFFER_HPP__
+#define __NETTCP_RECEIVE_BUFFER_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+#include <Net/Tcp/MemoryPool.hpp>
+
+// Stl Headers
+#include <cstddef>
+#include <cstdint>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/** Contiguous bytes owned by someone else, like a std::span */
+struct ByteView
+{
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+    bool isEmpty() const { return size == 0; }
+    const char* chars() const { return reinterpret_cast<const char*>(data); }
+    const std::uint8_t& operator[](std::size_t i) const { return data[i]; }
+};
+
+/**
+ * Received bytes not yet consumed, always contiguous so messages can be parsed in place.
+ * Bytes are appended after the data, and the data is moved back to the front of the storage only when there is
+ * no room left, so a message is copied at most once more after it was received. Storage come from MemoryPool.
+ * Not thread safe.
+ */
+class NETTCP_API_ ReceiveBuffer
+{
+    // ─────── API ─────────
+public:
+    ByteView view() const { return {_storage.data() + _begin, size()}; }
+    std::size_t size() const { return _storage.size() - _begin; }
+    bool isEmpty() const { return size() == 0; }
+    std::size_t capacity() const { return _storage.capacity(); }
+
+    // Room for at least length bytes after the data, filled then committed by commit
+    std::uint8_t* prepare(std::size_t length);
+    void commit(std::size_t length);
+    // Forget the first length bytes. Views stay valid until the next prepare
+    void consume(std::size_t length);
+
+    void clear();
+    // Give storage back to the pool. Return the released bytes, 0 if the buffer isn't empty
+    std::size_t release();
+
+private:
+    // Data is [_begin, _storage.size())
+    PooledBuffer _storage;
+    std::size_t _begin = 0;
+};
+
+}
+}
+
+#endif
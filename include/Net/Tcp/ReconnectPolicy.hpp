@@ -0,0 +1,86 @@
+#ifndef __NETTCP_RECONNECT_POLICY_HPP__
+#define __NETTCP_RECONNECT_POLICY_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Stl Headers
+#include <cstdint>
+#include <random>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Delay between reconnection attempts of a client.
+ * Delay start at initialDelay and is multiplied by multiplier after each failed attempt, up to maxDelay.
+ * Jitter spread clients that lost their server at the same time, so they don't reconnect in lockstep.
+ * Call reset() once connected.
+ */
+class NETTCP_API_ ReconnectPolicy
+{
+    // ─────── TYPES ─────────
+public:
+    enum class Jitter
+    {
+        // Exact exponential delay
+        None,
+        // Random between 0 and the exponential delay
+        Full,
+        // Random between initialDelay and 3 times the previous delay, capped to maxDelay. multiplier is ignored
+        Decorrelated,
+    };
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    // maxDelay of 0 means no limit
+    ReconnectPolicy(std::uint64_t initialDelay = 1000, double multiplier = 1., std::uint64_t maxDelay = 0,
+        Jitter jitter = Jitter::None);
+
+    // ─────── API ─────────
+public:
+    // Delay in ms before the next attempt. Count the attempt
+    std::uint64_t nextDelay();
+    // Next delay is initialDelay again
+    void reset();
+    // Attempts since last reset
+    std::uint32_t attempts() const { return _attempts; }
+
+    std::uint64_t initialDelay() const { return _initialDelay; }
+    void setInitialDelay(std::uint64_t value);
+    double multiplier() const { return _multiplier; }
+    // Clamped to 1
+    void setMultiplier(double value);
+    std::uint64_t maxDelay() const { return _maxDelay; }
+    void setMaxDelay(std::uint64_t value);
+    Jitter jitter() const { return _jitter; }
+    void setJitter(Jitter value);
+
+private:
+    double limit() const;
+    std::uint64_t random(std::uint64_t min, std::uint64_t max);
+
+private:
+    std::uint64_t _initialDelay;
+    double _multiplier;
+    std::uint64_t _maxDelay;
+    Jitter _jitter;
+
+    std::uint32_t _attempts = 0;
+    // Exponential delay of the next attempt, before jitter
+    double _backoff = 0;
+    // Last delay returned, used by Decorrelated jitter
+    double _previous = 0;
+    std::minstd_rand _random;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef __NETTCP_RECONNECT_SCHEDULER_HPP__
+#define __NETTCP_RECONNECT_SCHEDULER_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QObject>
+
+// Stl Headers
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Process wide limit of concurrent outgoing connection attempts, shared by every Socket.
+ * A socket acquire a slot before connecting, and release it once connected or failed.
+ * Disabled by default (maxConcurrentConnects is 0) : sockets connect without asking. Thread safe.
+ */
+class NETTCP_API_ ReconnectScheduler
+{
+    // ─────── TYPES ─────────
+public:
+    using Ticket = std::uint64_t;
+    // Called in the thread of the context, with the granted ticket
+    using Callback = std::function<void(Ticket)>;
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    static ReconnectScheduler& instance();
+
+    ReconnectScheduler(const ReconnectScheduler&) = delete;
+    ReconnectScheduler& operator=(const ReconnectScheduler&) = delete;
+
+private:
+    ReconnectScheduler() = default;
+
+    // ─────── API ─────────
+public:
+    // 0 to disable. Waiting sockets are granted if the limit is raised
+    void setMaxConcurrentConnects(int value);
+    int maxConcurrentConnects() const;
+    bool isEnabled() const;
+
+    /**
+     * Queue a request for a connect slot. granted is queued to context when the slot is available.
+     * Return a ticket, never 0, that must be released when the attempt is over, or when context is destroyed.
+     */
+    Ticket acquire(QObject* context, Callback granted);
+    // Free a granted slot or cancel a waiting request
+    void release(Ticket ticket);
+
+    int inFlight() const;
+    int waiting() const;
+
+private:
+    struct Waiter
+    {
+        Ticket ticket;
+        QObject* context;
+        Callback granted;
+    };
+
+    // Must be called with _mutex locked
+    void grant(Ticket ticket, QObject* context, Callback granted);
+    void grantWaiters();
+
+private:
+    mutable std::mutex _mutex;
+    int _maxConcurrentConnects = 0;
+    Ticket _nextTicket = 1;
+    std::unordered_set<Ticket> _granted;
+    std::deque<Waiter> _waiting;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __NETTCP_RPC_REPLY_HPP__
+#define __NETTCP_RPC_REPLY_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Handle on a request sent with RpcSocket::request, living in the RpcSocket thread.
+ * finished is emitted once, when the response is received, the deadline expired, or the connection is lost.
+ * The reply is a child of the RpcSocket : call deleteLater once handled.
+ */
+class NETTCP_API_ RpcReply : public QObject
+{
+    Q_OBJECT
+    // ──────── TYPES ────────
+public:
+    enum class Status
+    {
+        Pending,
+        Finished,
+        // No response before the deadline
+        TimedOut,
+        // Socket not connected when the request was written, or connection lost before the response
+        Aborted,
+    };
+    Q_ENUM(Status)
+
+    // ──────── CONSTRUCTOR ────────
+public:
+    RpcReply(quint64 id, QObject* parent = nullptr);
+
+    // ──────── API ────────
+public:
+    // Correlation id of the request
+    quint64 id() const { return _id; }
+    Status status() const { return _status; }
+    bool isFinished() const { return _status != Status::Pending; }
+    // Response payload, empty unless status is Finished
+    const QByteArray& payload() const { return _payload; }
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    friend class RpcSocket;
+    void finish(Status status, const QByteArray& payload);
+
+private:
+    const quint64 _id;
+    Status _status = Status::Pending;
+    QByteArray _payload;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __NETTCP_RPC_SOCKET_HPP__
+#define __NETTCP_RPC_SOCKET_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Socket.hpp>
+#include <Net/Tcp/RpcReply.hpp>
+
+// Qt Headers
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+class RpcSocketWorker;
+
+// ───── CLASS ─────
+
+/**
+ * Socket that multiplex requests and responses over one connection with RpcSocketWorker.
+ * Every request get a 64 bits correlation id : requests are pipelined without waiting for responses,
+ * and the peer can answer in any order.
+ * On the answering side, handle requestReceived and call reply with the same id.
+ * Override createRpcWorker to use a custom worker.
+ */
+class NETTCP_API_ RpcSocket : public Socket
+{
+    Q_OBJECT
+
+    // ──────── CONSTRUCTOR ────────
+public:
+    RpcSocket(QObject* parent = nullptr);
+    ~RpcSocket();
+
+    // ──────── ATTRIBUTES ────────
+protected:
+    // Deadline of request() in ms, rounded up to the TimerWheel resolution. 0 to wait until the connection is lost
+    NETTCP_PROPERTY(quint64, requestTimeout, RequestTimeout);
+    // Requests sent and not finished
+    NETTCP_PROPERTY_RO(int, pendingRequests, PendingRequests);
+
+    // ──────── C++ API ────────
+public Q_SLOTS:
+    bool stop() override;
+
+public:
+    /**
+     * Send a request with the worker, in the worker thread.
+     * Return a reply owned by this socket, that finish as Aborted if the socket isn't connected.
+     */
+    RpcReply* request(const QByteArray& payload);
+    RpcReply* request(const QByteArray& payload, quint64 timeout);
+    // Answer a request received with requestReceived. Return false if the socket isn't running
+    bool reply(quint64 id, const QByteArray& payload);
+
+Q_SIGNALS:
+    void requestReceived(quint64 id, const QByteArray& payload);
+
+    // ──────── CUSTOM WORKER API ────────
+protected:
+    SocketWorker* createWorker() override final;
+    virtual RpcSocketWorker* createRpcWorker();
+
+    // ──────── PRIVATE ────────
+private:
+    void onRequestFinished(quint64 id, int status, const QByteArray& payload);
+    void abortPendingReplies();
+
+private:
+    quint64 _nextRequestId = 1;
+    // Only accessed from the socket thread. Replies deleted by the user are null
+    QHash<quint64, QPointer<RpcReply>> _pendingReplies;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef __NETTCP_RPC_SOCKET_WORKER_HPP__
+#define __NETTCP_RPC_SOCKET_WORKER_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/FramedSocketWorker.hpp>
+
+// Stl Headers
+#include <unordered_map>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Worker of RpcSocket. Each frame carry one request or one response :
+ * a 1 byte message type, then the 64 bits big endian correlation id, then the user payload.
+ * Requests are pipelined and responses can come in any order.
+ * The table of pending requests is only accessed from the worker thread, so it doesn't need a lock.
+ */
+class NETTCP_API_ RpcSocketWorker : public FramedSocketWorker
+{
+    Q_OBJECT
+    // ──────── TYPES ────────
+public:
+    enum class MessageType : quint8
+    {
+        Request,
+        Response,
+    };
+
+    // Message type and correlation id
+    static const int messageHeaderSize = 9;
+
+    // ──────── CONSTRUCTOR ────────
+public:
+    RpcSocketWorker(QObject* parent = nullptr);
+
+    // ──────── API ────────
+public Q_SLOTS:
+    // Write a request. timeout in ms, 0 to wait until the connection is lost
+    void sendRequest(quint64 id, const QByteArray& payload, quint64 timeout);
+    void sendResponse(quint64 id, const QByteArray& payload);
+
+Q_SIGNALS:
+    // status is a RpcReply::Status
+    void requestFinished(quint64 id, int status, const QByteArray& payload);
+    void requestReceived(quint64 id, const QByteArray& payload);
+
+    // ──────── PRIVATE ────────
+protected:
+    void onFrameReceived(const QByteArray& payload) override;
+    void onDisconnected() override;
+
+private:
+    bool writeMessage(MessageType type, quint64 id, const QByteArray& payload);
+    void onRequestTimeout(quint64 id);
+    void abortPendingRequests();
+
+private:
+    struct PendingRequest
+    {
+        TimerWheel::Id timerId = 0;
+    };
+
+    std::unordered_map<quint64, PendingRequest> _pendingRequests;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef __NETTCP_SEND_SCHEDULER_HPP__
+#define __NETTCP_SEND_SCHEDULER_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QByteArray>
+
+// Stl Headers
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Outgoing messages of one connection, sorted in priority lanes. Lane 0 has the highest priority.
+ * Messages are taken back in chunks of at most chunkSize bytes, so a small message of a high priority lane
+ * only wait for the current chunk of a bulk message, not for the whole message.
+ * Chunks of one lane are always taken in order. Thread safe.
+ */
+class NETTCP_API_ SendScheduler
+{
+    // ─────── TYPES ─────────
+public:
+    enum class Policy
+    {
+        // Always serve the highest priority lane that isn't empty
+        StrictPriority,
+        // Serve each lane weight chunks in turn, so low priority lanes aren't starved
+        WeightedRoundRobin,
+    };
+
+    struct Chunk
+    {
+        int lane = 0;
+        QByteArray data;
+        // More chunks of the same message follow
+        bool more = false;
+    };
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    SendScheduler(int laneCount = 4, Policy policy = Policy::StrictPriority, int chunkSize = 16384);
+
+    SendScheduler(const SendScheduler&) = delete;
+    SendScheduler& operator=(const SendScheduler&) = delete;
+
+    // ─────── API ─────────
+public:
+    // lane is clamped to the lane count
+    void enqueue(int lane, const QByteArray& message);
+    // Take the next chunk. Return false if every lane is empty
+    bool next(Chunk& chunk);
+    bool isEmpty() const;
+    // Bytes not yet taken with next
+    std::size_t queuedBytes() const;
+    void clear();
+
+    int laneCount() const { return int(_lanes.size()); }
+    Policy policy() const;
+    void setPolicy(Policy value);
+    // Chunks served per round with WeightedRoundRobin. Clamped to 1
+    int weight(int lane) const;
+    void setWeight(int lane, int value);
+    int chunkSize() const;
+    // Clamped to 1
+    void setChunkSize(int value);
+
+private:
+    struct Lane
+    {
+        std::deque<QByteArray> messages;
+        // Bytes of the front message already taken
+        int offset = 0;
+        int weight = 1;
+        // Chunks left in the current round
+        int credit = 1;
+    };
+
+    int clampLane(int lane) const;
+    int pickLane();
+    Chunk takeChunk(int lane);
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<Lane> _lanes;
+    Policy _policy;
+    int _chunkSize;
+    // Lane served by WeightedRoundRobin
+    int _current = 0;
+    std::size_t _queuedBytes = 0;
+};
+
+}
+}
+
+#endif
@@ -6,6 +6,11 @@
 // Library Headers
 #include <Net/Tcp/IServer.hpp>
 
+// Stl Headers
+#include <functional>
+#include <memory>
+#include <vector>
+
 // ───── DECLARATION ─────
 
 QT_FORWARD_DECLARE_CLASS(QTimer);
@@ -14,6 +19,9 @@ namespace net {
 namespace tcp {
 
 class ServerWorker;
+class EventLoopMonitor;
+class TokenBucket;
+class TrafficRecorder;
 
 // ───── CLASS ─────
 
@@ -45,10 +53,29 @@ public Q_SLOTS:
     QList<Socket*> getSockets(const QString& address) const override final;
     void disconnectFrom(const QString& address, const quint16 port) override final;
     void disconnectFrom(const QString& address) override final;
+    QVariantMap tcpInfoSummary() const override final;
+    // Kernel option properties given to clients
+    SocketOptions socketOptions() const;
 
 protected:
     virtual bool canAcceptNewClient() const;
 
+    // ──────── BROADCAST ────────
+public:
+    using BroadcastFilter = std::function<bool(const Socket*)>;
+
+public Q_SLOTS:
+    /**
+     * Write data to every client with Socket::send semantics, and return the number of clients.
+     * Every client share the same buffer, and each worker thread receive one event for the whole broadcast,
+     * instead of one copy and one event per client.
+     */
+    int broadcast(const QByteArray& data);
+
+public:
+    // Only write to clients accepted by filter. filter is called in the server thread
+    int broadcast(const QByteArray& data, const BroadcastFilter& filter);
+
     // ──────── CUSTOM SOCKET API ────────
 protected:
     virtual class Socket* newSocket(QObject* parent);
@@ -61,10 +88,36 @@ private:
     bool stopWorker();
     void startWatchdog();
     void stopWatchdog();
+    void applyMonitorEventLoop();
+
+    // ──────── SOCKET POOL ────────
+private:
+    // Pooled socket if any, otherwise a new one. Refill the pool later
+    Socket* takeSocket();
+    // Remove socket from the clients without destroying it, the server stay its parent
+    void takeClient(Socket* socket);
+    // Give a removed socket back to the pool, or destroy it if the pool is full
+    void recycleSocket(Socket* socket);
+    void fillSocketPool();
+    // Forward changed kernel options to connected clients
+    void applySocketOptions();
+    void clearSocketPool();
+    void applySocketPoolSize();
+
+private:
+    std::vector<Socket*> _socketPool;
+    bool _socketPoolRefillPending = false;
 
 private:
     ServerWorker* _worker = nullptr;
     QTimer* _watchdog = nullptr;
+    // Shared with the workers of clients that live in the server thread
+    std::shared_ptr<EventLoopMonitor> _eventLoopMonitor;
+    // Aggregate rate limits, shared by every client worker
+    std::shared_ptr<TokenBucket> _rxBucket;
+    std::shared_ptr<TokenBucket> _txBucket;
+    // Held while recordPath is set, clients come and go without truncating the file
+    std::shared_ptr<TrafficRecorder> _recorder;
 };
 
 }
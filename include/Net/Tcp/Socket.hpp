@@ -5,8 +5,10 @@
 
 // Library Headers
 #include <Net/Tcp/ISocket.hpp>
+#include <Net/Tcp/SocketOptions.hpp>
 
 // Stl Headers
+#include <memory>
 
 // ───── DECLARATION ─────
 
@@ -16,6 +18,8 @@ namespace net {
 namespace tcp {
 
 class SocketWorker;
+class TokenBucket;
+class TrafficRecorder;
 
 // ───── CLASS ─────
 
@@ -47,18 +51,76 @@ public Q_SLOTS:
     void clearTxCounter() override;
     void clearCounters() override;
 
+    /**
+     * Create the worker, its thread and connections without starting it, so next start() only bind the worker.
+     * Return false if the socket is running or already prepared.
+     */
+    bool prepare();
+    /**
+     * Close the connection but keep the worker alive, in its thread and connected, to be started again.
+     * Reset the connection state and counters. Workers must reset their own state in onConnected.
+     * Return false if there is no worker.
+     */
+    bool recycle();
+
+    /**
+     * Write data with the worker, in the worker thread.
+     * Data is dropped if the socket isn't connected, unless outboundQueueSize is set.
+     * Call from the socket thread. Return false if the socket isn't running.
+     */
+    bool send(const QByteArray& data);
+    /**
+     * Send the latest value of key, for feeds where a slow peer only need the newest value.
+     * While the socket is congested (see conflationThreshold), data is held per key and replaced by newer data
+     * of the same key, keeping its place in the send order.
+     * Data is dropped if the socket isn't connected. Return false if the socket isn't running.
+     */
+    bool sendConflated(quint64 key, const QByteArray& data);
+    // Bytes given to send, or written by the worker, and not yet written to the kernel
+    quint64 queuedBytes() const;
+
+    // Kernel option properties at once
+    SocketOptions socketOptions() const;
+    void setSocketOptions(const SocketOptions& options);
+
     // ──────── WORKER ────────
 private:
     SocketWorker* _worker = nullptr;
     QThread* _workerThread = nullptr;
+    // Rate limits shared by every client of a Server, given to the worker on start
+    std::shared_ptr<TokenBucket> _serverRxBucket;
+    std::shared_ptr<TokenBucket> _serverTxBucket;
+    // Held while recordPath is set, so a restart append to the file instead of truncating it
+    std::shared_ptr<TrafficRecorder> _recorder;
+    // setSocketOptions is changing the properties, postSocketOptions wait for the last one
+    bool _settingSocketOptions = false;
+
+private:
+    bool setupWorker();
+    // Copy socket properties to the worker before it starts
+    void configureWorker();
+    // Count data as queued, and return the worker that must write it. nullptr if the socket isn't running
+    SocketWorker* queueSend(const QByteArray& data);
+    // Give changed kernel options to the worker
+    void postSocketOptions();
 
 private Q_SLOTS:
     void killWorker();
+    void onRecordPathChanged();
     void onStartSuccess(
         const QString& peerAddress, const quint16 peerPort, const QString& localAddress, const quint16 localPort);
     void onStartFail();
     void onBytesReceived(const uint64_t count);
     void onBytesSent(const uint64_t count);
+    void onEventLoopStatsUpdated(quint64 lag, qreal load, quint64 wakeupsPerSeconds);
+    void onTcpInfoUpdated(quint32 rtt, quint32 rttVariance, quint32 congestionWindow, quint32 retransmits,
+        quint32 unackedSegments, quint32 sendQueueBytes);
+    void onIdleBuffersReleased(quint64 bytes);
+    void onOutboundDropped(quint64 count);
+    void onConflationUpdated(quint64 conflated, quint64 dropped);
+    void onThrottleChanged(bool rx, bool tx);
+    void onHeartbeatUpdated(quint64 rtt, quint64 jitter);
+    void onReadStatsUpdated(quint64 budgetExceeded, quint64 dispatchTimeMax, quint64 requeueLatencyMax);
 
 Q_SIGNALS:
     void startWorker();
@@ -67,6 +129,13 @@ Q_SIGNALS:
     // ──────── CUSTOM WORKER API ────────
 protected:
     virtual SocketWorker* createWorker();
+    // Current worker, nullptr when stopped. Only call its slots with a queued invocation
+    SocketWorker* worker() const { return _worker; }
+
+    // ──────── FRIENDS ────────
+private:
+    // Server::broadcast post to workers directly, and share its rate limits
+    friend class Server;
 };
 
 }
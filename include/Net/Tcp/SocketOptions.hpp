@@ -0,0 +1,76 @@
+#ifndef __NETTCP_SOCKET_OPTIONS_HPP__
+#define __NETTCP_SOCKET_OPTIONS_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QVariantMap>
+
+// ───── DECLARATION ─────
+
+QT_FORWARD_DECLARE_CLASS(QAbstractSocket);
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Kernel options of a connected socket. 0 (or false) leave the current value of an option,
+ * except keepalive, userTimeout and quickAck that go back to the system default when they are set back to 0.
+ * Buffer sizes, keepalive and type of service are portable, other options are only supported on Linux.
+ */
+struct NETTCP_API_ SocketOptions
+{
+    // SO_RCVBUF and SO_SNDBUF in bytes
+    int receiveBufferSize = 0;
+    int sendBufferSize = 0;
+    // Enable SO_KEEPALIVE, with a first probe after keepAliveIdle s without traffic (TCP_KEEPIDLE)
+    int keepAliveIdle = 0;
+    // TCP_KEEPINTVL in s, and TCP_KEEPCNT probes before the connection is dropped
+    int keepAliveInterval = 0;
+    int keepAliveCount = 0;
+    // TCP_USER_TIMEOUT : drop the connection when sent data isn't acknowledged after this delay in ms
+    int userTimeout = 0;
+    // TCP_QUICKACK : the kernel clear it by itself, the worker set it again after each read
+    bool quickAck = false;
+    // TCP_NOTSENT_LOWAT : socket is writable while less than this many bytes are not yet sent
+    int notSentLowWatermark = 0;
+    // IP_TOS, like 0x10 for low delay or a DSCP value shifted by 2
+    int typeOfService = 0;
+    // SO_PRIORITY of the outgoing packets, 0 to 6
+    int priority = 0;
+
+    bool operator==(const SocketOptions& other) const;
+    bool operator!=(const SocketOptions& other) const { return !(*this == other); }
+
+    /**
+     * Apply options to a connected socket. previous are the options applied before to this socket, so options
+     * set back to 0 can be restored. Return false if an option is refused by the kernel.
+     */
+    bool apply(QAbstractSocket* socket, const SocketOptions& previous = {}) const;
+    /**
+     * Values used by the kernel, keyed like the ISocket properties. Linux report doubled buffer sizes.
+     * Options not supported on this platform are missing.
+     */
+    static QVariantMap effective(QAbstractSocket* socket);
+    // Set TCP_QUICKACK again
+    static void rearmQuickAck(qintptr socketDescriptor);
+
+    /**
+     * SO_RCVLOWAT : the socket isn't readable until bytes are received, or the connection is closed.
+     * Only supported on Linux. Return false on error or if not supported.
+     */
+    static bool setReceiveLowWatermark(qintptr socketDescriptor, int bytes);
+    static bool isReceiveLowWatermarkSupported();
+    // Bytes received by the kernel and not yet read. 0 on error or if not supported
+    static int kernelBytesAvailable(qintptr socketDescriptor);
+};
+
+}
+}
+
+#endif
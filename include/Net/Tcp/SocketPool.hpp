@@ -0,0 +1,150 @@
+#ifndef __NETTCP_SOCKET_POOL_HPP__
+#define __NETTCP_SOCKET_POOL_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Socket.hpp>
+
+// Dependencies Headers
+#include <QOlm/QOlm.hpp>
+
+// Qt Headers
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+
+// ───── DECLARATION ─────
+
+QT_FORWARD_DECLARE_CLASS(QTimer);
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Keep poolSize client Socket connected to the same peer, and dispatch send() between them.
+ * Bulk transfers aren't limited anymore by the window of one connection and by one worker thread.
+ * Disconnected members reconnect on their own, with their own watchdog and ReconnectPolicy.
+ * Members that failed to start are destroyed and replaced after replaceTimeout.
+ * Override newSocket to use a custom Socket and SocketWorker.
+ */
+class NETTCP_API_ SocketPool : public qolm::QOlm<Socket>
+{
+    Q_OBJECT
+    NETTCP_REGISTER_TO_QML(SocketPool)
+
+    // ──────── TYPES ────────
+public:
+    enum class Strategy
+    {
+        // Next connected member
+        RoundRobin,
+        // Connected member with the fewest bytes waiting to be written
+        LeastQueued,
+        // Same key always use the same member while it is connected
+        KeyAffinity,
+    };
+
+    // ──────── CONSTRUCTOR ────────
+public:
+    SocketPool(QObject* parent = nullptr);
+    ~SocketPool();
+
+    // ──────── ATTRIBUTES ────────
+protected:
+    NETTCP_PROPERTY_RO(bool, isRunning, Running);
+    NETTCP_PROPERTY(QString, peerAddress, PeerAddress);
+    NETTCP_PROPERTY(quint16, peerPort, PeerPort);
+    // Number of sockets to the peer
+    NETTCP_PROPERTY_D(int, poolSize, PoolSize, 4);
+    // Strategy : 0 RoundRobin, 1 LeastQueued, 2 KeyAffinity
+    NETTCP_PROPERTY(int, strategy, Strategy);
+    NETTCP_PROPERTY_D(bool, useWorkerThread, UseWorkerThread, true);
+    NETTCP_PROPERTY_D(bool, noDelay, NoDelay, true);
+    NETTCP_PROPERTY_D(quint64, watchdogPeriod, WatchdogPeriod, 5000);
+    // Forwarded to every member, see ISocket
+    NETTCP_PROPERTY_D(qreal, reconnectMultiplier, ReconnectMultiplier, 1.);
+    NETTCP_PROPERTY(quint64, reconnectMaxDelay, ReconnectMaxDelay);
+    NETTCP_PROPERTY(int, reconnectJitter, ReconnectJitter);
+    NETTCP_PROPERTY(quint64, connectTimeout, ConnectTimeout);
+    NETTCP_PROPERTY_D(quint64, connectAttemptDelay, ConnectAttemptDelay, 250);
+    NETTCP_PROPERTY(quint64, outboundQueueSize, OutboundQueueSize);
+    NETTCP_PROPERTY(quint64, outboundQueueMaxAge, OutboundQueueMaxAge);
+    NETTCP_PROPERTY(int, outboundQueueDropPolicy, OutboundQueueDropPolicy);
+    NETTCP_PROPERTY(quint64, heartbeatPeriod, HeartbeatPeriod);
+    NETTCP_PROPERTY_D(int, heartbeatMaxMissed, HeartbeatMaxMissed, 3);
+    NETTCP_PROPERTY(quint64, rxRateLimit, RxRateLimit);
+    NETTCP_PROPERTY(quint64, txRateLimit, TxRateLimit);
+    // Replace a member that is not running (its start failed) for longer than this in ms. 0 to disable.
+    // Members that are only disconnected are never replaced, so their reconnect backoff is kept
+    NETTCP_PROPERTY_D(quint64, replaceTimeout, ReplaceTimeout, 30000);
+
+    // ──────── STATUS ────────
+protected:
+    // Updated every second
+    NETTCP_PROPERTY_RO(int, connectedCount, ConnectedCount);
+    NETTCP_PROPERTY_RO(quint64, rxBytesPerSeconds, RxBytesPerSeconds);
+    NETTCP_PROPERTY_RO(quint64, txBytesPerSeconds, TxBytesPerSeconds);
+    NETTCP_PROPERTY_RO(quint64, rxBytesTotal, RxBytesTotal);
+    NETTCP_PROPERTY_RO(quint64, txBytesTotal, TxBytesTotal);
+    NETTCP_PROPERTY_RO(quint64, queuedBytes, QueuedBytes);
+    // Members destroyed because they failed to start
+    NETTCP_PROPERTY_RO(quint64, replacedCount, ReplacedCount);
+    // send() that found no connected member
+    NETTCP_PROPERTY_RO(quint64, droppedCount, DroppedCount);
+
+    // ──────── C++ API ────────
+public Q_SLOTS:
+    bool start();
+    bool start(const QString& host, const quint16 port);
+    bool stop();
+    bool restart();
+
+    /**
+     * Send data with a connected member chosen by strategy.
+     * With KeyAffinity, data without a key is sent round robin.
+     * Return false if no member is connected.
+     */
+    bool send(const QByteArray& data);
+    bool send(const QByteArray& data, quint64 key);
+
+public:
+    // Member chosen for key, nullptr if none is connected. key is ignored unless strategy is KeyAffinity
+    Socket* pick(quint64 key = 0);
+
+    // ──────── CUSTOM SOCKET API ────────
+protected:
+    virtual Socket* newSocket(QObject* parent);
+
+    // ──────── PRIVATE ────────
+private:
+    Socket* pickRoundRobin();
+    Socket* pickLeastQueued();
+    Socket* pickKeyAffinity(quint64 key);
+
+    Socket* addMember();
+    // Copy settings of the pool to socket
+    void configureMember(Socket* socket) const;
+    void configureMembers();
+    void replaceMember(Socket* socket);
+    void resize();
+    void checkHealth();
+
+private:
+    QTimer* _healthTimer = nullptr;
+    int _nextMember = 0;
+    // Since when each member is not running
+    QHash<Socket*, QElapsedTimer> _stoppedSince;
+    // Counters of destroyed members, so totals don't go backward
+    quint64 _rxBytesTotalRemoved = 0;
+    quint64 _txBytesTotalRemoved = 0;
+
+Q_SIGNALS:
+    void memberReplaced(int index);
+};
+
+}
+}
+
+#endif
@@ -5,24 +5,46 @@
 
 // Library Headers
 #include <Net/Tcp/Export.hpp>
+#include <Net/Tcp/MemoryPool.hpp>
+#include <Net/Tcp/ReceiveBuffer.hpp>
+#include <Net/Tcp/ReconnectPolicy.hpp>
+#include <Net/Tcp/ReconnectScheduler.hpp>
+#include <Net/Tcp/SocketOptions.hpp>
+#include <Net/Tcp/TimerWheel.hpp>
+#include <Net/Tcp/TokenBucket.hpp>
 
 // Qt Headers
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtNetwork/QAbstractSocket>
+#include <QtNetwork/QHostAddress>
+
+// Stl Headers
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 // ───── DECLARATION ─────
 
 QT_FORWARD_DECLARE_CLASS(QTcpSocket);
+QT_FORWARD_DECLARE_CLASS(QHostInfo);
 QT_FORWARD_DECLARE_CLASS(QTimer);
 
 namespace net {
 namespace tcp {
 
+class EventLoopMonitor;
+class TrafficRecorder;
+
 // ───── CLASS ─────
 
 class NETTCP_API_ SocketWorker : public QObject
 {
     Q_OBJECT
+    // One worker per connection, recycled between connections
+    NETTCP_POOL_ALLOCATED
     // ──────── CONSTRUCTOR ────────
 public:
     SocketWorker(QObject* parent = nullptr);
@@ -38,6 +60,8 @@ private:
     // Try to optimize the socket for low latency.
     // Set the TCP_NODELAY option and disable Nagle's algorithm.
     bool _noDelay = true;
+    // Don't name objects, and use the thread TimerWheel instead of per connection QTimer. See ISocket::slimMode
+    bool _slimMode = false;
     quintptr _socketDescriptor = 0;
     QString _address;
     quint16 _port = 0;
@@ -53,22 +77,310 @@ public Q_SLOTS:
 
 private:
     void applyNoDelayOption() const;
+    // Connect _socket signals to the worker
+    void connectSocketSignals();
+
+    // ──────── SOCKET OPTIONS ────────
+public:
+    // Call from the worker thread. Applied immediately when connected, and on every connection
+    void setSocketOptions(const SocketOptions& options);
+
+private:
+    // previous are the options applied before on the current connection, to restore options set back to 0
+    void applySocketOptions(const SocketOptions& previous = {});
+
+private:
+    SocketOptions _socketOptions;
+
+Q_SIGNALS:
+    // Options used by the kernel once applied. See SocketOptions::effective
+    void socketOptionsApplied(const QVariantMap& effective);
+
+    // ──────── CONNECTION ATTEMPTS ────────
+public Q_SLOTS:
+    void setConnectTimeout(quint64 value);
+    void setConnectAttemptDelay(quint64 value);
+
+private:
+    // Resolve _address with HostCache or QHostInfo, then connect to resolved addresses
+    void connectToHost();
+    void onHostResolved(const QHostInfo& info);
+    void connectToAddresses(const QList<QHostAddress>& addresses);
+    void startNextAttempt();
+    void onAttemptConnected(QTcpSocket* attempt);
+    void onAttemptFailed(QTcpSocket* attempt);
+    void onConnectTimeout();
+    void abortConnectAttempts();
+
+private:
+    // Abort the connection if not connected after this delay in ms. 0 to rely on the system timeout
+    quint64 _connectTimeout = 0;
+    // Start a parallel attempt to the next address if the current one doesn't answer after this delay in ms
+    quint64 _connectAttemptDelay = 250;
+    // Addresses not tried yet, families interleaved
+    QList<QHostAddress> _pendingAddresses;
+    // Sockets connecting in parallel, the first connected become _socket
+    std::vector<QTcpSocket*> _attempts;
+    int _hostLookupId = -1;
+    // Invalidate host lookups of previous connections
+    quint32 _connectGeneration = 0;
+    TimerWheel::Id _connectTimerId = 0;
+    TimerWheel::Id _attemptTimerId = 0;
 
     // ──────── WRITE API ────────
 public:
     std::size_t write(const std::uint8_t* buffer, const std::size_t length);
     std::size_t write(const char* buffer, const std::size_t length);
 
+    // Bytes given to Socket::send or write and not yet written to the kernel. Thread safe
+    quint64 queuedBytes() const;
+
+protected:
+    // Bytes buffered by the socket, not yet written to the kernel
+    std::size_t bytesToWrite() const;
+    // Account bytes held by a derived worker in queuedBytes. Thread safe
+    void addQueuedBytes(qint64 bytes) { _queuedBytes += bytes; }
+    // Write bytes that aren't application traffic, like heartbeats. Same as write, but the connection stays idle
+    std::size_t writeControl(const char* buffer, std::size_t length);
+    // Called when the kernel accepted buffered bytes, to write more data held by a derived worker
+    virtual void onWriteProgress(qint64 bytes);
+    /**
+     * Write one message given to Socket::send, Socket::sendConflated or Server::broadcast.
+     * The default implementation write it as is in the byte stream. See FramedSocketWorker
+     */
+    virtual bool writeMessage(const QByteArray& message);
+
+public Q_SLOTS:
+    // Write data if connected, otherwise drop it. Used by Socket::send and Server::broadcast
+    virtual void onSendData(const QByteArray& data);
+
+private Q_SLOTS:
+    void onBytesWritten(qint64 bytes);
+
+private:
+    // Write, pace and account length bytes, return 0 if the socket is closed
+    std::size_t writeBytes(const char* buffer, std::size_t length);
+
+private:
+    // Can be negative for a short time, while a Socket::send isn't yet processed
+    std::atomic<qint64> _queuedBytes {0};
+
+    // ──────── OUTBOUND QUEUE ────────
+public Q_SLOTS:
+    void setOutboundQueueSize(quint64 value);
+    void setOutboundQueueMaxAge(quint64 value);
+    void setOutboundQueueDropPolicy(int value);
+
+private:
+    struct OutboundMessage
+    {
+        // Empty for bytes given directly to write(), they aren't sent again
+        QByteArray data;
+        qint64 size = 0;
+        // _outboundClock time when queued
+        qint64 time = 0;
+    };
+
+    void enqueueOutbound(const QByteArray& data);
+    // Drop messages above outboundQueueSize according to the drop policy
+    void trimOutboundQueue();
+    void dropExpiredOutbound();
+    // Write the whole queue at once
+    void flushOutboundQueue();
+    // Messages not fully written to the kernel go back to the front of the queue
+    void requeueInFlight();
+    void clearOutboundQueue();
+
+private:
+    // 0 when disabled
+    quint64 _outboundQueueSize = 0;
+    quint64 _outboundQueueMaxAge = 0;
+    // 0 drop oldest, 1 drop newest
+    int _outboundQueueDropPolicy = 0;
+    std::deque<OutboundMessage> _outboundQueue;
+    quint64 _outboundQueueBytes = 0;
+    // Given to the socket and not yet reported by bytesWritten
+    std::deque<OutboundMessage> _inFlight;
+    qint64 _inFlightWritten = 0;
+    // write() is called with messages already in _inFlight
+    bool _flushingOutbound = false;
+    QElapsedTimer _outboundClock;
+
+Q_SIGNALS:
+    void outboundDropped(quint64 count);
+
+    // ──────── CONFLATION ────────
+public Q_SLOTS:
+    void setConflationThreshold(quint64 value);
+    void setConflationMaxKeys(int value);
+    // Write data, or hold it in place of the held data of the same key while the socket is congested.
+    // Used by Socket::sendConflated
+    virtual void onSendConflated(quint64 key, const QByteArray& data);
+
+protected:
+    // More than conflationThreshold bytes wait to be written to the kernel
+    virtual bool isCongested() const;
+    quint64 conflationThreshold() const { return _conflationThreshold; }
+
+private:
+    // Write held data in send order until the socket is congested again
+    void flushConflationQueue();
+    // Held data is dropped with the connection
+    void clearConflationQueue();
+    // Counters are reported with the bytes counters, not for every message
+    void reportConflation();
+
+private:
+    quint64 _conflationThreshold = 65536;
+    int _conflationMaxKeys = 0;
+    // Held keys in send order, and their latest data
+    std::deque<quint64> _conflationOrder;
+    std::unordered_map<quint64, QByteArray> _conflationQueue;
+    quint64 _conflatedCounter = 0;
+    quint64 _conflationDroppedCounter = 0;
+
+Q_SIGNALS:
+    void conflationUpdated(quint64 conflated, quint64 dropped);
+
+    // ──────── RATE LIMIT ────────
+public Q_SLOTS:
+    // Bytes per seconds, 0 for unlimited
+    void setRxRateLimit(quint64 value);
+    void setTxRateLimit(quint64 value);
+
+private:
+    // Tokens of the socket bucket and of the server bucket
+    qint64 rxTokens();
+    qint64 txTokens();
+    bool isRxLimited() const;
+    bool isTxLimited() const;
+    void consumeRx(std::size_t bytes);
+    void consumeTx(std::size_t bytes);
+
+    // Write length bytes to the socket, return false if the socket was closed
+    bool writeToSocket(const char* buffer, std::size_t length);
+    // Bytes of a write that can be given to the socket now, the rest is paced
+    std::size_t txAllowance(std::size_t length);
+    void startPacingTimer();
+    void flushPacedData();
+
+    void pauseRx();
+    void resumeRx();
+    // Cap the socket read buffer to the burst, so the kernel buffer fill and TCP flow control slow down the peer
+    void applyReadBufferSize() const;
+    void updateThrottle();
+    void clearRateLimitState();
+
+private:
+    TokenBucket _rxBucket;
+    TokenBucket _txBucket;
+    // Shared by every client of a Server, can be nullptr
+    std::shared_ptr<TokenBucket> _serverRxBucket;
+    std::shared_ptr<TokenBucket> _serverTxBucket;
+    // Bytes written above the tx limit, given to the socket by the pacing timer
+    QByteArray _pacedData;
+    TimerWheel::Id _pacingTimerId = 0;
+    TimerWheel::Id _rxResumeTimerId = 0;
+    bool _rxPaused = false;
+    bool _rxThrottled = false;
+    bool _txThrottled = false;
+
+Q_SIGNALS:
+    void throttleChanged(bool rx, bool tx);
+
     // ──────── READ API ────────
 protected Q_SLOTS:
     bool isConnected() const;
     virtual void onDataAvailable();
 
+private Q_SLOTS:
+    void onReadyRead();
+
 public:
     std::size_t bytesAvailable() const;
     std::size_t read(std::uint8_t* data, std::size_t maxLen);
     std::size_t read(char* data, std::size_t maxLen);
 
+    /**
+     * Read without copy to the caller : bytes available are moved to a receive buffer owned by the worker,
+     * and every unconsumed byte is returned as one contiguous view, to parse messages in place.
+     * The view is valid until the next peek or readView. Call consume to advance.
+     */
+    ByteView peek();
+    // Up to maxLen bytes, already consumed
+    ByteView readView(std::size_t maxLen);
+    void consume(std::size_t length);
+
+protected:
+    // length bytes read by onDataAvailable aren't application traffic, like heartbeats.
+    // A read of only such bytes doesn't count as activity for idleTimeout
+    void onControlBytesRead(std::size_t length) { _dispatchControlBytes += length; }
+
+private:
+    // Move bytes available in the socket, within the read budget, to the receive buffer
+    void fillReceiveBuffer();
+    // Count bytes read from the socket
+    void onBytesRead(const char* data, std::size_t length);
+
+private:
+    ReceiveBuffer _receiveBuffer;
+
+    // ──────── READ BUDGET ────────
+public Q_SLOTS:
+    void setReadBudget(quint64 value);
+
+private:
+    // Call onDataAvailable with the read budget, and requeue the socket if the budget cut it
+    void dispatchRead();
+    void requeueRead();
+    // Stats are reported with the bytes counters, not for every read
+    void reportReadStats();
+
+private:
+    // Bytes read by one onDataAvailable call, 0 for no limit
+    quint64 _readBudget = 0;
+    // Left to the running dispatch
+    quint64 _readBudgetLeft = 0;
+    bool _readDispatching = false;
+    // Bytes read by the running dispatch, and how many of them are control bytes
+    std::size_t _dispatchBytesRead = 0;
+    std::size_t _dispatchControlBytes = 0;
+    // A dispatch is posted to the event loop
+    bool _readRequeued = false;
+    qint64 _readRequeuedAt = 0;
+    QElapsedTimer _readClock;
+    quint64 _readBudgetExceededCounter = 0;
+    // Over the current period, in µs
+    quint64 _readDispatchTimeMax = 0;
+    quint64 _readRequeueLatencyMax = 0;
+    bool _readStatsReported = false;
+
+Q_SIGNALS:
+    void readStatsUpdated(quint64 budgetExceeded, quint64 dispatchTimeMax, quint64 requeueLatencyMax);
+
+    // ──────── READ COALESCING ────────
+public Q_SLOTS:
+    void setReadLowWatermark(int value);
+    void setReadMaxDelay(quint64 value);
+
+private:
+    void startReadCoalescing();
+    void stopReadCoalescing();
+    // Called every readMaxDelay ms, lower the watermark if no read happened and bytes wait below it
+    void onReadCoalescingTimeout();
+    // Called on every readyRead
+    void onReadCoalesced();
+
+private:
+    // SO_RCVLOWAT in bytes, 0 to disable
+    int _readLowWatermark = 0;
+    quint64 _readMaxDelay = 1;
+    TimerWheel::Id _readCoalescingTimerId = 0;
+    // A read happened since the last onReadCoalescingTimeout
+    bool _readSinceCheck = false;
+    // Watermark is lowered to 1 byte until the next read
+    bool _readFlushing = false;
+
     // ──────── COMMUNICATION TO SOCKET ────────
 protected Q_SLOTS:
     void onSocketError(const QAbstractSocket::SocketError e);
@@ -93,11 +405,73 @@ private:
     uint64_t _watchdogPeriod = 1000;
     QTimer* _watchdog = nullptr;
 
+    // ──────── RECONNECT ────────
+public Q_SLOTS:
+    void setReconnectMultiplier(qreal value);
+    void setReconnectMaxDelay(quint64 value);
+    void setReconnectJitter(int value);
+
+private:
+    // Give back the ReconnectScheduler slot, once the connection attempt is over
+    void releaseConnectSlot();
+
+private:
+    // Initial delay is _watchdogPeriod
+    ReconnectPolicy _reconnectPolicy;
+    ReconnectScheduler::Ticket _connectTicket = 0;
+    bool _connectSlotGranted = false;
+
+    // ──────── HEARTBEAT ────────
+public:
+    enum class HeartbeatKind : quint8
+    {
+        Ping = 0,
+        Pong = 1,
+    };
+    // Kind, then the 64 bits big endian send time of the ping in µs, echoed by the pong
+    static const int heartbeatSize = 9;
+
+public Q_SLOTS:
+    void setHeartbeatPeriod(quint64 value);
+    void setHeartbeatMaxMissed(int value);
+
+protected:
+    /**
+     * Write a heartbeat out of band of the data. A byte stream can't carry them :
+     * the default implementation return false and heartbeats stay disabled. See FramedSocketWorker
+     */
+    virtual bool writeHeartbeat(const QByteArray& heartbeat);
+    // Call with data received out of band. Answer pings, measure pongs, and return false if it isn't a heartbeat
+    bool onHeartbeatReceived(const QByteArray& heartbeat);
+
+private:
+    void startHeartbeat();
+    void stopHeartbeat();
+    void resetHeartbeatRtt();
+    void onHeartbeatTick();
+    static QByteArray encodeHeartbeat(HeartbeatKind kind, quint64 time);
+
+private:
+    quint64 _heartbeatPeriod = 0;
+    int _heartbeatMaxMissed = 3;
+    TimerWheel::Id _heartbeatTimerId = 0;
+    // A ping wait for its pong
+    bool _heartbeatPending = false;
+    int _heartbeatMissed = 0;
+    // Smoothed like TCP retransmission timer (RFC 6298), in µs. 0 until the first pong
+    quint64 _heartbeatSrtt = 0;
+    quint64 _heartbeatRttVar = 0;
+
+Q_SIGNALS:
+    void heartbeatUpdated(quint64 rtt, quint64 jitter);
+
     // ──────── STATISTICS ────────
 private:
     quint64 _rxBytesCounter = 0;
     quint64 _txBytesCounter = 0;
     QTimer* _bytesCounterTimer = nullptr;
+    // Used instead of _bytesCounterTimer in slim mode
+    TimerWheel::Id _bytesCounterTimerId = 0;
 
 protected:
     void startBytesCounter();
@@ -110,6 +484,85 @@ Q_SIGNALS:
     void bytesReceived(const quint64 rx);
     void bytesSent(const quint64 tx);
 
+    // ──────── IDLE PARKING ────────
+public Q_SLOTS:
+    void setIdleTimeout(quint64 timeout);
+
+protected:
+    /**
+     * Called when the connection is parked after idleTimeout ms without traffic.
+     * Free buffers that can be allocated again on next use, and return the number of released bytes.
+     * The default implementation release the receive buffer of peek, the storage of paced writes and the buckets
+     * of the conflation queue. QTcpSocket keep one drained block of its own and has no API to shrink it.
+     */
+    virtual std::size_t releaseIdleBuffers();
+    bool isParked() const { return _parked; }
+
+private:
+    void startIdleTimer();
+    void stopIdleTimer();
+    void checkIdle();
+    void park();
+    // Called on every read or write of application traffic
+    void onActivity();
+
+private:
+    quint64 _idleTimeout = 0;
+    TimerWheel::Id _idleTimerId = 0;
+    // Traffic since the last idle check
+    bool _activity = false;
+    bool _parked = false;
+
+Q_SIGNALS:
+    void idleChanged(bool idle);
+    void idleBuffersReleased(quint64 bytes);
+
+    // ──────── EVENT LOOP MONITOR ────────
+public Q_SLOTS:
+    void setMonitorEventLoop(bool value);
+
+private:
+    void applyMonitorEventLoop();
+
+private:
+    bool _monitorEventLoop = false;
+    // Shared with every worker of the thread. See EventLoopMonitor::forCurrentThread
+    std::shared_ptr<EventLoopMonitor> _eventLoopMonitor;
+
+Q_SIGNALS:
+    void eventLoopStatsUpdated(quint64 lag, qreal load, quint64 wakeupsPerSeconds);
+
+    // ──────── TCP INFO ────────
+public Q_SLOTS:
+    void setTcpInfoPeriod(quint64 period);
+
+private Q_SLOTS:
+    void sampleTcpInfo();
+
+private:
+    void startTcpInfoSampling();
+    void stopTcpInfoSampling();
+
+private:
+    quint64 _tcpInfoPeriod = 0;
+    QTimer* _tcpInfoTimer = nullptr;
+
+Q_SIGNALS:
+    void tcpInfoUpdated(quint32 rtt, quint32 rttVariance, quint32 congestionWindow, quint32 retransmits,
+        quint32 unackedSegments, quint32 sendQueueBytes);
+
+    // ──────── TRAFFIC RECORD ────────
+public:
+    // Thread safe. nullptr to stop recording
+    void setTrafficRecorder(std::shared_ptr<TrafficRecorder> recorder);
+
+private:
+    void newRecordConnection();
+
+private:
+    std::shared_ptr<TrafficRecorder> _recorder;
+    std::uint32_t _recordConnection = 0;
+
     // ──────── FRIENDS ────────
 private:
     friend class Socket;
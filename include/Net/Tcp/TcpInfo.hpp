@@ -0,0 +1,43 @@
+#ifndef __NETTCP_TCP_INFO_HPP__
+#define __NETTCP_TCP_INFO_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtGlobal>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/** Subset of kernel TCP_INFO useful to diagnose slow links */
+struct NETTCP_API_ TcpInfo
+{
+    // Smoothed round trip time in µs
+    quint32 rtt = 0;
+    // Round trip time variance in µs
+    quint32 rttVariance = 0;
+    // Congestion window in segments
+    quint32 congestionWindow = 0;
+    // Total count of retransmitted segments
+    quint32 retransmits = 0;
+    // Segments sent but not yet acknowledged
+    quint32 unackedSegments = 0;
+    // Bytes in the kernel send queue
+    quint32 sendQueueBytes = 0;
+
+    /** Fill info from a native socket descriptor. Return false if not supported on this platform or on error. */
+    static bool read(qintptr socketDescriptor, TcpInfo& info);
+    static bool isSupported();
+};
+
+}
+}
+
+#endif
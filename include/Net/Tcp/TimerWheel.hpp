@@ -0,0 +1,96 @@
+#ifndef __NETTCP_TIMER_WHEEL_HPP__
+#define __NETTCP_TIMER_WHEEL_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+// Stl Headers
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// ───── DECLARATION ─────
+
+QT_FORWARD_DECLARE_CLASS(QTimer);
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Hashed timing wheel shared by every connection of a thread.
+ * Thousands of coarse per connection timers (bytes counter, idle parking, heartbeat)
+ * cost one QTimer ticking every resolution ms, instead of one QTimer per connection.
+ * Not thread safe : only use the wheel from the thread it lives in.
+ */
+class NETTCP_API_ TimerWheel : public QObject
+{
+    Q_OBJECT
+    // ──────── TYPES ────────
+public:
+    using Id = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    // ──────── CONSTRUCTOR ────────
+public:
+    TimerWheel(int resolution = 100, QObject* parent = nullptr);
+    ~TimerWheel();
+
+    // Wheel of the calling thread with this resolution, created on first call.
+    // Destroyed when the thread finish, or with QCoreApplication
+    static TimerWheel* instance(int resolution = 100);
+
+    // ──────── API ────────
+public:
+    /**
+     * Call callback after interval ms, rounded up to resolution. Every interval ms if repeat.
+     * The timer is dropped if context is destroyed, like a QObject::connect context.
+     * Return an id to stop the timer, never 0.
+     */
+    Id start(int interval, QObject* context, Callback callback, bool repeat = false);
+    void stop(Id id);
+    bool isActive(Id id) const;
+
+    int resolution() const;
+    // Number of active timers
+    std::size_t size() const;
+
+private Q_SLOTS:
+    void onTick();
+
+private:
+    struct Entry
+    {
+        std::uint64_t deadline = 0;
+        std::uint64_t period = 0;
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    void schedule(Id id, std::uint64_t deadline);
+    std::uint64_t elapsedTicks() const;
+
+private:
+    const int _resolution;
+    QTimer* _timer = nullptr;
+    QElapsedTimer _clock;
+    // Last processed tick
+    std::uint64_t _tick = 0;
+    Id _nextId = 1;
+    std::vector<std::vector<Id>> _buckets;
+    std::unordered_map<Id, Entry> _entries;
+};
+
+}
+}
+
+#endif
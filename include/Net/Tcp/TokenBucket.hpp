@@ -0,0 +1,73 @@
+#ifndef __NETTCP_TOKEN_BUCKET_HPP__
+#define __NETTCP_TOKEN_BUCKET_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Stl Headers
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Rate limiter in bytes per second. The bucket refill at rate bytes per second up to burst bytes,
+ * and transferred bytes are taken from it. consume can take more than available : the debt is paid by waiting.
+ * A rate of 0 means no limit. Thread safe, so one bucket can shape every connection of a Server.
+ */
+class NETTCP_API_ TokenBucket
+{
+    // ─────── TYPES ─────────
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    // burst of 0 use a tenth of rate, at least 4 KB
+    TokenBucket(std::uint64_t rate = 0, std::uint64_t burst = 0);
+
+    TokenBucket(const TokenBucket&) = delete;
+    TokenBucket& operator=(const TokenBucket&) = delete;
+
+    // ─────── API ─────────
+public:
+    void setRate(std::uint64_t rate, std::uint64_t burst = 0);
+    std::uint64_t rate() const;
+    std::uint64_t burst() const;
+    // Lock free, cheap enough for every read and write
+    bool isLimited() const { return _rate.load(std::memory_order_relaxed) != 0; }
+
+    // Bytes that can be transferred now, negative while in debt
+    std::int64_t available();
+    void consume(std::uint64_t bytes);
+    // Delay in ms until bytes are available, at least 1 ms when not available now
+    std::uint64_t delayFor(std::uint64_t bytes);
+
+    // Same with an explicit time, for tests
+    std::int64_t available(Clock::time_point now);
+    std::uint64_t delayFor(std::uint64_t bytes, Clock::time_point now);
+
+private:
+    void refill(Clock::time_point now);
+
+private:
+    mutable std::mutex _mutex;
+    std::atomic<std::uint64_t> _rate {0};
+    std::uint64_t _burst = 0;
+    double _tokens = 0;
+    Clock::time_point _last;
+};
+
+}
+}
+
+#endif
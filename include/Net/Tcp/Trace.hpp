@@ -0,0 +1,101 @@
+#ifndef __NETTCP_TRACE_HPP__
+#define __NETTCP_TRACE_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QString>
+
+// Stl Headers
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Record socket lifecycle and hot path events, and export them as Chrome trace json
+ * (chrome://tracing, https://ui.perfetto.dev).
+ *
+ * Events are recorded into a fixed size ring buffer per thread, without lock.
+ * Recording only happens when the library is built with NETTCP_ENABLE_TRACE, and when setEnabled(true) have been called.
+ * Dump is best effort : events recorded while dumping might be skipped.
+ */
+class NETTCP_API_ Trace
+{
+    // ─────── TYPES ─────────
+public:
+    struct Event
+    {
+        const char* category = nullptr;
+        const char* name = nullptr;
+        const void* id = nullptr;
+        // Timestamp in µs
+        std::uint64_t timestamp = 0;
+        // Duration in µs, only for complete event
+        std::uint64_t duration = 0;
+        std::uint64_t value = 0;
+        // Chrome trace phase. 'i' for instant, 'X' for complete
+        char phase = 'i';
+    };
+
+    /** Record a complete event for the lifetime of the scope */
+    class NETTCP_API_ Scope
+    {
+    public:
+        Scope(const char* category, const char* name, const void* id, std::uint64_t value = 0);
+        ~Scope();
+
+    private:
+        const char* _category;
+        const char* _name;
+        const void* _id;
+        std::uint64_t _value;
+        std::uint64_t _begin;
+        bool _enabled;
+    };
+
+    // ─────── API ─────────
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    // Number of events kept per thread. Rounded up to a power of 2. Only apply to threads that didn't trace yet.
+    static void setBufferSize(std::size_t size);
+    static std::size_t bufferSize();
+
+    static std::uint64_t now();
+    static void instant(const char* category, const char* name, const void* id, std::uint64_t value = 0);
+    static void complete(const char* category, const char* name, const void* id, std::uint64_t begin,
+        std::uint64_t duration, std::uint64_t value = 0);
+
+    static std::string toChromeJson();
+    static bool dump(const QString& path);
+    static void clear();
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+}
+}
+
+// clang-format off
+#ifdef NETTCP_ENABLE_TRACE
+# define NETTCP_TRACE_INSTANT(category, name, id, ...) do { if(net::tcp::Trace::isEnabled()) net::tcp::Trace::instant(category, name, id, ## __VA_ARGS__); } while (0)
+# define NETTCP_TRACE_SCOPE(category, name, id, ...)   net::tcp::Trace::Scope _nettcpTraceScope(category, name, id, ## __VA_ARGS__)
+#else
+# define NETTCP_TRACE_INSTANT(category, name, id, ...) do {} while (0)
+# define NETTCP_TRACE_SCOPE(category, name, id, ...)   do {} while (0)
+#endif
+// clang-format on
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef __NETTCP_TRAFFIC_RECORDER_HPP__
+#define __NETTCP_TRAFFIC_RECORDER_HPP__
+
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Export.hpp>
+
+// Qt Headers
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+// Stl Headers
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// ───── DECLARATION ─────
+
+namespace net {
+namespace tcp {
+
+// ───── CLASS ─────
+
+/**
+ * Append timestamped rx/tx chunks of every connection to a memory mapped file.
+ *
+ * File layout (little endian):
+ * - Header : "NTCPREC" | version (u8) | recording start in ms since epoch (u64)
+ * - Chunks : timestamp in µs since recording start (u64) | connection (u32) | direction (u8) | length (u32) | data
+ *
+ * The file grows by preallocated blocks, and is truncated to its real size when the recorder is destroyed.
+ * Connection ids start at 1, a chunk with connection 0 mark the end of a file that wasn't closed properly.
+ */
+class NETTCP_API_ TrafficRecorder
+{
+    // ─────── TYPES ─────────
+public:
+    enum class Direction : std::uint8_t
+    {
+        Rx = 0,
+        Tx = 1,
+    };
+
+    static const char magic[7];
+    static const std::uint8_t version = 1;
+    static const std::size_t headerSize = 16;
+    static const std::size_t chunkHeaderSize = 17;
+
+    // ─────── CONSTRUCTOR ─────────
+public:
+    /**
+     * Recorders are shared per path, so every socket of a server append to the same file.
+     * The file is truncated when no recorder of this path is alive : Socket and Server hold theirs while recordPath
+     * is set, so connections coming and going keep appending.
+     */
+    static std::shared_ptr<TrafficRecorder> open(const QString& path);
+    ~TrafficRecorder();
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+private:
+    TrafficRecorder(const QString& path);
+
+    // ─────── API ─────────
+public:
+    bool isOpen() const;
+    QString path() const;
+    // Bytes used in the file
+    std::uint64_t size() const;
+
+    // Thread safe
+    std::uint32_t newConnectionId();
+    void record(std::uint32_t connection, Direction direction, const char* data, std::size_t length);
+
+private:
+    bool reserve(std::size_t length);
+    void close();
+
+private:
+    QFile _file;
+    uchar* _map = nullptr;
+    std::uint64_t _capacity = 0;
+    std::uint64_t _size = 0;
+    QElapsedTimer _clock;
+    mutable std::mutex _mutex;
+    std::atomic<std::uint32_t> _nextConnectionId {1};
+};
+
+/** Read back a file written by TrafficRecorder */
+class NETTCP_API_ TrafficReader
+{
+    // ─────── TYPES ─────────
+public:
+    struct Chunk
+    {
+        // µs since recording start
+        std::uint64_t timestamp = 0;
+        std::uint32_t connection = 0;
+        TrafficRecorder::Direction direction = TrafficRecorder::Direction::Rx;
+        QByteArray data;
+    };
+
+    // ─────── API ─────────
+public:
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const;
+    // Recording start in ms since epoch
+    std::uint64_t startTime() const;
+    // Return false at the end of the file
+    bool next(Chunk& chunk);
+    void rewind();
+
+private:
+    QFile _file;
+    const uchar* _map = nullptr;
+    std::uint64_t _fileSize = 0;
+    std::uint64_t _offset = 0;
+    std::uint64_t _startTime = 0;
+};
+
+}
+}
+
+#endif
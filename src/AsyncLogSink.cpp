@@ -0,0 +1,265 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/AsyncLogSink.hpp>
+
+// Stl Headers
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// Upper bound of the time a lost wake up can delay a message
+static const auto maxSleep = std::chrono::milliseconds(10);
+static const auto waitPeriod = std::chrono::milliseconds(1);
+
+static std::size_t roundUpPowerOfTwo(std::size_t size)
+{
+    std::size_t powerOfTwo = 2;
+    while(powerOfTwo < size) powerOfTwo <<= 1;
+    return powerOfTwo;
+}
+
+// ───── CLASS ─────
+
+AsyncLogSink::AsyncLogSink(std::size_t queueSize, OverflowPolicy policy) :
+    _policy(policy), _mask(roundUpPowerOfTwo(queueSize) - 1), _slots(new Slot[_mask + 1])
+{
+    for(std::size_t i = 0; i <= _mask; ++i) _slots[i].sequence.store(i, std::memory_order_relaxed);
+    _thread = std::thread([this]() { run(); });
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+    _running.store(false);
+    {
+        std::lock_guard<std::mutex> lock(_wakeUpMutex);
+        _wakeUp.notify_one();
+    }
+    if(_thread.joinable())
+        _thread.join();
+
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    for(const auto& sink: _sinks) sink->flush();
+}
+
+void AsyncLogSink::addSink(const SinkPtr& sink)
+{
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    _sinks.push_back(sink);
+}
+
+void AsyncLogSink::removeSink(const SinkPtr& sink)
+{
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    _sinks.erase(std::remove(_sinks.begin(), _sinks.end(), sink), _sinks.end());
+}
+
+std::vector<AsyncLogSink::SinkPtr> AsyncLogSink::sinks() const
+{
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    return _sinks;
+}
+
+bool AsyncLogSink::tryPush(const spdlog::details::log_msg& msg)
+{
+    Slot* slot = nullptr;
+    auto pos = _enqueuePos.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        slot = &_slots[pos & _mask];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = std::intptr_t(sequence) - std::intptr_t(pos);
+        if(diff == 0)
+        {
+            if(_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        // Queue is full
+        else if(diff < 0)
+            return false;
+        else
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    slot->msg = spdlog::details::log_msg_buffer(msg);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogSink::tryPop(spdlog::details::log_msg_buffer& msg)
+{
+    Slot* slot = nullptr;
+    auto pos = _dequeuePos.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        slot = &_slots[pos & _mask];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = std::intptr_t(sequence) - std::intptr_t(pos + 1);
+        if(diff == 0)
+        {
+            if(_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        // Queue is empty
+        else if(diff < 0)
+            return false;
+        else
+            pos = _dequeuePos.load(std::memory_order_relaxed);
+    }
+
+    msg = slot->msg;
+    slot->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogSink::isEmpty() const
+{
+    const auto pos = _dequeuePos.load(std::memory_order_relaxed);
+    const auto sequence = _slots[pos & _mask].sequence.load(std::memory_order_acquire);
+    return std::intptr_t(sequence) - std::intptr_t(pos + 1) < 0;
+}
+
+void AsyncLogSink::wakeUpWorker()
+{
+    // Pair with the fence in run() so either the worker see the new message, or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(_sleeping.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(_wakeUpMutex);
+        _wakeUp.notify_one();
+    }
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg)
+{
+    if(tryPush(msg))
+    {
+        ++_queued;
+        wakeUpWorker();
+        return;
+    }
+
+    switch(_policy)
+    {
+    case OverflowPolicy::DropNewest: ++_droppedNewest; return;
+    case OverflowPolicy::DropOldest:
+    {
+        spdlog::details::log_msg_buffer oldest;
+        do
+        {
+            if(tryPop(oldest))
+                ++_droppedOldest;
+        } while(!tryPush(msg));
+        ++_queued;
+        wakeUpWorker();
+        return;
+    }
+    case OverflowPolicy::Block:
+    {
+        ++_blocked;
+        ++_waiters;
+        while(!tryPush(msg))
+        {
+            wakeUpWorker();
+            std::unique_lock<std::mutex> lock(_wakeUpMutex);
+            _progress.wait_for(lock, waitPeriod);
+        }
+        --_waiters;
+        ++_queued;
+        wakeUpWorker();
+        return;
+    }
+    }
+}
+
+void AsyncLogSink::flush()
+{
+    const auto ticket = _queued.load();
+
+    ++_waiters;
+    while(_processed.load() + _droppedOldest.load() < ticket)
+    {
+        wakeUpWorker();
+        std::unique_lock<std::mutex> lock(_wakeUpMutex);
+        _progress.wait_for(lock, waitPeriod);
+    }
+    --_waiters;
+
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    for(const auto& sink: _sinks) sink->flush();
+}
+
+void AsyncLogSink::set_pattern(const std::string& pattern)
+{
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    for(const auto& sink: _sinks) sink->set_pattern(pattern);
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+    std::lock_guard<std::mutex> lock(_sinksMutex);
+    for(const auto& sink: _sinks) sink->set_formatter(formatter->clone());
+}
+
+AsyncLogSink::OverflowPolicy AsyncLogSink::overflowPolicy() const { return _policy; }
+
+std::size_t AsyncLogSink::queueSize() const { return _mask + 1; }
+
+AsyncLogSink::Stats AsyncLogSink::stats() const
+{
+    Stats stats;
+    stats.queued = _queued.load();
+    stats.processed = _processed.load();
+    stats.droppedOldest = _droppedOldest.load();
+    stats.droppedNewest = _droppedNewest.load();
+    stats.blocked = _blocked.load();
+    return stats;
+}
+
+void AsyncLogSink::run()
+{
+    spdlog::details::log_msg_buffer msg;
+    for(;;)
+    {
+        if(tryPop(msg))
+        {
+            {
+                std::lock_guard<std::mutex> lock(_sinksMutex);
+                for(const auto& sink: _sinks)
+                {
+                    if(sink->should_log(msg.level))
+                        sink->log(msg);
+                }
+            }
+            ++_processed;
+
+            if(_waiters.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(_wakeUpMutex);
+                _progress.notify_all();
+            }
+            continue;
+        }
+
+        // Drain the queue before exiting
+        if(!_running.load())
+            break;
+
+        std::unique_lock<std::mutex> lock(_wakeUpMutex);
+        _sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(isEmpty() && _running.load())
+        {
+            _progress.notify_all();
+            _wakeUp.wait_for(lock, maxSleep);
+        }
+        _sleeping.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(_wakeUpMutex);
+    _progress.notify_all();
+}
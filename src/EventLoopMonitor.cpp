@@ -0,0 +1,175 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/EventLoopMonitor.hpp>
+
+// Qt Headers
+#include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+// Stl Headers
+#include <algorithm>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+static const QEvent::Type probeEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+class ProbeEvent : public QEvent
+{
+public:
+    ProbeEvent(qint64 expectedAt) : QEvent(probeEventType), expectedAt(expectedAt) {}
+    // Time at which the probe should have been delivered on an idle loop (ns)
+    const qint64 expectedAt;
+};
+
+// ───── CLASS ─────
+
+EventLoopMonitor::EventLoopMonitor(QObject* parent) : QObject(parent)
+{
+    connect(this, &EventLoopMonitor::probePeriodChanged, this,
+        [this](quint64 period)
+        {
+            if(_probeTimer)
+                _probeTimer->setInterval(int(period));
+        });
+}
+
+EventLoopMonitor::~EventLoopMonitor() = default;
+
+void EventLoopMonitor::start()
+{
+    if(_probeTimer)
+        return;
+
+    Q_ASSERT(thread() == QThread::currentThread());
+
+    _clock.start();
+    _lastProbe = 0;
+    _windowStart = 0;
+    _blockedSince = -1;
+    _idleTime = 0;
+    _wakeups = 0;
+    _windowMaxLag = 0;
+
+    if(auto* dispatcher = QAbstractEventDispatcher::instance(thread()))
+    {
+        // Dispatcher live in the same thread, but be explicit since those signals are hot
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &EventLoopMonitor::onAboutToBlock,
+            Qt::DirectConnection);
+        connect(dispatcher, &QAbstractEventDispatcher::awake, this, &EventLoopMonitor::onAwake, Qt::DirectConnection);
+    }
+
+    _probeTimer = new QTimer(this);
+    _probeTimer->setObjectName("probe");
+    _probeTimer->setTimerType(Qt::PreciseTimer);
+    _probeTimer->setInterval(int(probePeriod()));
+    connect(_probeTimer, &QTimer::timeout, this, &EventLoopMonitor::onProbeTimeout);
+    _probeTimer->start();
+}
+
+void EventLoopMonitor::stop()
+{
+    if(!_probeTimer)
+        return;
+
+    if(auto* dispatcher = QAbstractEventDispatcher::instance(thread()))
+        disconnect(dispatcher, nullptr, this, nullptr);
+
+    _probeTimer->stop();
+    _probeTimer->deleteLater();
+    _probeTimer = nullptr;
+
+    resetLag();
+    resetMaxLag();
+    resetLoad();
+    resetWakeupsPerSeconds();
+}
+
+bool EventLoopMonitor::isActive() const { return _probeTimer != nullptr; }
+
+std::shared_ptr<EventLoopMonitor> EventLoopMonitor::forCurrentThread()
+{
+    // Weak, so a thread without monitored socket doesn't probe its event loop
+    static thread_local std::weak_ptr<EventLoopMonitor> threadMonitor;
+
+    auto monitor = threadMonitor.lock();
+    if(monitor)
+        return monitor;
+
+    monitor = std::shared_ptr<EventLoopMonitor>(new EventLoopMonitor,
+        [](EventLoopMonitor* released)
+        {
+            released->stop();
+            // The last owner might be handling a signal of the monitor
+            released->deleteLater();
+        });
+    monitor->setObjectName("eventLoopMonitor");
+    monitor->start();
+    threadMonitor = monitor;
+    return monitor;
+}
+
+bool EventLoopMonitor::event(QEvent* e)
+{
+    if(e->type() == probeEventType)
+    {
+        if(_probeTimer)
+        {
+            const auto* probe = static_cast<ProbeEvent*>(e);
+            const auto lagUs = quint64(std::max<qint64>(0, _clock.nsecsElapsed() - probe->expectedAt) / 1000);
+            setLag(lagUs);
+            _windowMaxLag = std::max(_windowMaxLag, lagUs);
+        }
+        return true;
+    }
+    return QObject::event(e);
+}
+
+void EventLoopMonitor::onProbeTimeout()
+{
+    const auto now = _clock.nsecsElapsed();
+
+    // A late timer is part of the lag too, so the probe is stamped with the time the timer should have fired
+    const auto period = qint64(probePeriod()) * 1000000;
+    const auto expectedAt = _lastProbe ? std::min(now, _lastProbe + period) : now;
+    _lastProbe = now;
+
+    QCoreApplication::postEvent(this, new ProbeEvent(expectedAt));
+
+    if(now - _windowStart >= 1000000000)
+        publishStats(now);
+}
+
+void EventLoopMonitor::onAboutToBlock() { _blockedSince = _clock.nsecsElapsed(); }
+
+void EventLoopMonitor::onAwake()
+{
+    if(_blockedSince >= 0)
+    {
+        _idleTime += _clock.nsecsElapsed() - _blockedSince;
+        _blockedSince = -1;
+    }
+    ++_wakeups;
+}
+
+void EventLoopMonitor::publishStats(qint64 now)
+{
+    const auto window = now - _windowStart;
+    if(window <= 0)
+        return;
+
+    setMaxLag(_windowMaxLag);
+    setLoad(qBound(qreal(0), qreal(1) - qreal(_idleTime) / qreal(window), qreal(1)));
+    setWakeupsPerSeconds(quint64(_wakeups * 1000000000ull / quint64(window)));
+    Q_EMIT statsUpdated(maxLag(), load(), wakeupsPerSeconds());
+
+    _windowStart = now;
+    _idleTime = 0;
+    _wakeups = 0;
+    _windowMaxLag = 0;
+}
@@ -0,0 +1,288 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/FramedSocketWorker.hpp>
+#include <Net/Tcp/Logger.hpp>
+
+// Qt Headers
+#include <QtCore/QtEndian>
+
+// Stl Headers
+#include <algorithm>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// clang-format off
+#ifdef NDEBUG
+# define LOG_DEV_DEBUG(str, ...) do {} while (0)
+#else
+# define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#endif
+
+#ifdef NDEBUG
+# define LOG_DEV_WARN(str, ...)  do {} while (0)
+#else
+# define LOG_DEV_WARN(str, ...)  NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#endif
+
+#define LOG_ERR(str, ...)        NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+// clang-format on
+
+// ───── CLASS ─────
+
+const int FramedSocketWorker::headerSize;
+const quint32 FramedSocketWorker::maxPayloadSize;
+const int FramedSocketWorker::flagsShift;
+const int FramedSocketWorker::laneCount;
+const quint32 FramedSocketWorker::maxInPlacePayloadSize;
+
+FramedSocketWorker::FramedSocketWorker(QObject* parent) : SocketWorker(parent) {}
+
+quint32 FramedSocketWorker::encodeHeader(quint32 payloadSize, quint8 flags)
+{
+    Q_ASSERT(payloadSize <= maxPayloadSize);
+    return (quint32(flags) << flagsShift) | (payloadSize & maxPayloadSize);
+}
+
+void FramedSocketWorker::sendFrame(const QByteArray& payload, int lane)
+{
+    _sendScheduler.enqueue(lane, payload);
+    addQueuedBytes(payload.size());
+
+    // One pump write every message queued until it runs
+    if(!_pumpPending.exchange(true))
+    {
+        QMetaObject::invokeMethod(
+            this,
+            [this]()
+            {
+                _pumpPending = false;
+                pumpSendScheduler();
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+bool FramedSocketWorker::writeFrame(const QByteArray& payload, int lane)
+{
+    if(!isConnected())
+        return false;
+
+    if(quint32(payload.size()) > _maxFrameSize)
+    {
+        LOG_ERR("Can't write message of {} bytes, maxFrameSize is {}", payload.size(), _maxFrameSize);
+        return false;
+    }
+
+    _sendScheduler.enqueue(lane, payload);
+    addQueuedBytes(payload.size());
+    pumpSendScheduler();
+    return true;
+}
+
+void FramedSocketWorker::setMaxFrameSize(quint32 value) { _maxFrameSize = std::min(value, maxPayloadSize); }
+
+void FramedSocketWorker::onSendData(const QByteArray& data)
+{
+    // Counted by Socket::send, writeFrame count it again
+    addQueuedBytes(-qint64(data.size()));
+    if(!writeFrame(data))
+        LOG_DEV_DEBUG("Drop message of {} bytes sent while not connected", data.size());
+}
+
+bool FramedSocketWorker::writeMessage(const QByteArray& message) { return writeFrame(message); }
+
+bool FramedSocketWorker::isCongested() const
+{
+    return quint64(bytesToWrite() + _sendScheduler.queuedBytes()) > conflationThreshold();
+}
+
+bool FramedSocketWorker::writeControlFrame(const QByteArray& payload)
+{
+    if(!isConnected())
+        return false;
+
+    // Frames already in the socket buffer are whole, the control frame is written after a frame boundary.
+    // Control frames aren't traffic, a connection exchanging only heartbeats can be parked
+    char header[headerSize];
+    qToBigEndian(encodeHeader(quint32(payload.size()), Control), header);
+    writeControl(header, headerSize);
+    if(!payload.isEmpty())
+        writeControl(payload.constData(), std::size_t(payload.size()));
+    return true;
+}
+
+bool FramedSocketWorker::writeHeartbeat(const QByteArray& heartbeat) { return writeControlFrame(heartbeat); }
+
+void FramedSocketWorker::onWriteProgress(qint64) { pumpSendScheduler(); }
+
+void FramedSocketWorker::pumpSendScheduler()
+{
+    // Messages are dropped like Socket::send data
+    if(!isConnected())
+    {
+        dropQueuedMessages();
+        return;
+    }
+
+    const auto chunkSize = std::size_t(_sendScheduler.chunkSize());
+    SendScheduler::Chunk chunk;
+    // write can close the socket
+    while(isConnected() && bytesToWrite() < chunkSize && _sendScheduler.next(chunk))
+    {
+        // write count them again
+        addQueuedBytes(-qint64(chunk.data.size()));
+
+        const auto flags = quint8(chunk.lane & LaneMask) | quint8(chunk.more ? More : 0);
+        char header[headerSize];
+        qToBigEndian(encodeHeader(quint32(chunk.data.size()), flags), header);
+        write(header, headerSize);
+        if(!chunk.data.isEmpty())
+            write(chunk.data.constData(), std::size_t(chunk.data.size()));
+    }
+}
+
+void FramedSocketWorker::dropQueuedMessages()
+{
+    if(_sendScheduler.isEmpty())
+        return;
+
+    const auto bytes = _sendScheduler.queuedBytes();
+    LOG_DEV_DEBUG("Drop {} bytes of queued messages, socket isn't connected", bytes);
+    addQueuedBytes(-qint64(bytes));
+    _sendScheduler.clear();
+}
+
+void FramedSocketWorker::onDataAvailable()
+{
+    for(;;)
+    {
+        // A big payload is read in its own buffer, the receive buffer would grow to its size
+        if(!_payload.isEmpty())
+        {
+            const auto toRead = std::min(bytesAvailable(), std::size_t(_payload.size() - _payloadRead));
+            _payloadRead += int(read(_payload.data() + _payloadRead, toRead));
+            if(_payloadRead < _payload.size())
+                return;
+
+            // Handlers might keep the payload, start the next frame with a new buffer
+            QByteArray payload;
+            payload.swap(_payload);
+            const auto flags = _frameFlags;
+            _frameFlags = 0;
+            _payloadRead = 0;
+
+            if(!onFrame(flags, std::move(payload), false))
+                return;
+            continue;
+        }
+
+        // Other frames are parsed in place, in the receive buffer
+        const auto view = peek();
+        if(view.size < std::size_t(headerSize))
+            return;
+
+        const auto header = qFromBigEndian<quint32>(view.data);
+        const auto payloadSize = headerPayloadSize(header);
+        if(payloadSize > _maxFrameSize)
+        {
+            LOG_ERR("Frame of {} bytes is bigger than maxFrameSize {}, close the connection", payloadSize,
+                _maxFrameSize);
+            resetFrame();
+            closeSocket();
+            return;
+        }
+
+        if(payloadSize > maxInPlacePayloadSize)
+        {
+            consume(headerSize);
+            _frameFlags = headerFlags(header);
+            _payload.resize(int(payloadSize));
+            _payloadRead = 0;
+            continue;
+        }
+
+        // Wait for the rest of the frame
+        if(view.size < headerSize + payloadSize)
+            return;
+
+        // Consumed before the handler, that can close the socket. The view stay valid until the next peek
+        consume(headerSize + payloadSize);
+        if(!onFrame(headerFlags(header), QByteArray::fromRawData(view.chars() + headerSize, int(payloadSize)), true))
+            return;
+    }
+}
+
+bool FramedSocketWorker::onFrame(quint8 flags, QByteArray payload, bool inPlace)
+{
+    if(flags & Control)
+    {
+        onControlBytesRead(headerSize + std::size_t(payload.size()));
+        onControlFrameReceived(payload);
+        return true;
+    }
+
+    auto& partial = _partialMessages[std::size_t(flags & LaneMask)];
+    if(partial.isEmpty() && !(flags & More))
+    {
+        _payloadInPlace = inPlace;
+        onFrameReceived(payload);
+        _payloadInPlace = false;
+        return true;
+    }
+
+    if(quint64(partial.size()) + quint64(payload.size()) > _maxFrameSize)
+    {
+        LOG_ERR("Message of more than {} bytes is bigger than maxFrameSize {}, close the connection",
+            partial.size() + payload.size(), _maxFrameSize);
+        resetFrame();
+        closeSocket();
+        return false;
+    }
+
+    partial.append(payload);
+    if(flags & More)
+        return true;
+
+    QByteArray message;
+    message.swap(partial);
+    onFrameReceived(message);
+    return true;
+}
+
+void FramedSocketWorker::onConnected()
+{
+    // Worker can be recycled, drop the partial frame of the previous connection
+    resetFrame();
+    SocketWorker::onConnected();
+}
+
+void FramedSocketWorker::onDisconnected()
+{
+    // A message split in frames can't continue on the next connection
+    dropQueuedMessages();
+    resetFrame();
+    SocketWorker::onDisconnected();
+}
+
+void FramedSocketWorker::onFrameReceived(const QByteArray& payload)
+{
+    // Receivers can be queued, they get their own copy of a payload parsed in place
+    Q_EMIT frameReceived(_payloadInPlace ? QByteArray(payload.constData(), payload.size()) : payload);
+}
+
+void FramedSocketWorker::onControlFrameReceived(const QByteArray& payload)
+{
+    if(!onHeartbeatReceived(payload))
+        LOG_DEV_WARN("Drop control frame of {} bytes", payload.size());
+}
+
+void FramedSocketWorker::resetFrame()
+{
+    _frameFlags = 0;
+    _payload.clear();
+    _payloadRead = 0;
+    for(auto& partial: _partialMessages) partial.clear();
+}
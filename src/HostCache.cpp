@@ -0,0 +1,72 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/HostCache.hpp>
+
+// Stl Headers
+#include <algorithm>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+HostCache& HostCache::instance()
+{
+    // Never destroyed, workers might resolve during static destruction
+    static auto* cache = new HostCache;
+    return *cache;
+}
+
+void HostCache::setTtl(int ttl)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _ttl = std::max(ttl, 0);
+    if(!_ttl)
+        _entries.clear();
+}
+
+int HostCache::ttl() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _ttl;
+}
+
+bool HostCache::lookup(const QString& host, QList<QHostAddress>& addresses)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto it = _entries.find(host);
+    if(it == _entries.end())
+        return false;
+
+    if(Clock::now() >= it->expiry)
+    {
+        _entries.erase(it);
+        return false;
+    }
+
+    addresses = it->addresses;
+    return true;
+}
+
+void HostCache::insert(const QString& host, const QList<QHostAddress>& addresses)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(!_ttl || addresses.isEmpty())
+        return;
+
+    _entries.insert(host, {addresses, Clock::now() + std::chrono::milliseconds(_ttl)});
+}
+
+void HostCache::remove(const QString& host)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.remove(host);
+}
+
+void HostCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
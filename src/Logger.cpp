@@ -4,6 +4,16 @@
 // Library Headers
 #include <Net/Tcp/Logger.hpp>
 
+// Stl Headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // ───── DECLARATION ─────
 
 using namespace net::tcp;
@@ -26,28 +36,369 @@ const Logger::LogPtr Logger::UTILS = makeLog(UTILS_NAME);
 
 const Logger::LogList Logger::LOGGERS = {SERVER, SOCKET, SOCKET_WORKER, UTILS};
 
+namespace {
+
+struct SinkRegistry
+{
+    std::mutex mutex;
+    // Sinks installed with registerSink
+    std::vector<Logger::SinkPtr> sinks;
+    // When set, loggers only have this sink, that forward to sinks
+    std::shared_ptr<AsyncLogSink> async;
+};
+
+SinkRegistry& registry()
+{
+    static SinkRegistry r;
+    return r;
+}
+
+using Clock = std::chrono::steady_clock;
+
+struct ThrottleKey
+{
+    const Logger::Log* log;
+    const char* site;
+    const void* object;
+    std::uint64_t variant;
+
+    bool operator==(const ThrottleKey& other) const
+    {
+        return log == other.log && site == other.site && object == other.object && variant == other.variant;
+    }
+};
+
+struct ThrottleKeyHash
+{
+    std::size_t operator()(const ThrottleKey& key) const
+    {
+        const std::hash<const void*> hash;
+        auto h = hash(key.log);
+        h = h * 31 + hash(key.site);
+        h = h * 31 + hash(key.object);
+        h = h * 31 + std::hash<std::uint64_t>()(key.variant);
+        return h;
+    }
+};
+
+struct ThrottleEntry
+{
+    Clock::time_point windowStart;
+    std::uint64_t suppressed = 0;
+    spdlog::level::level_enum level = spdlog::level::info;
+    // Last suppressed message, formatted
+    std::string lastMessage;
+};
+
+struct ThrottleSummary
+{
+    Logger::Log* log;
+    const char* site;
+    const void* object;
+    spdlog::level::level_enum level;
+    std::uint64_t suppressed;
+    std::int64_t elapsed;
+    std::string message;
+};
+
+// Keys are spread over shards, so sockets logging from different threads rarely share a lock,
+// and a sweep only walks the keys of one shard.
+struct alignas(64) ThrottleShard
+{
+    std::mutex mutex;
+    std::unordered_map<ThrottleKey, ThrottleEntry, ThrottleKeyHash> entries;
+    Clock::time_point lastSweep;
+};
+
+struct ThrottleRegistry
+{
+    static constexpr std::size_t shardCount = 16;
+
+    ThrottleShard shards[shardCount];
+    std::atomic<int> period {1000};
+    std::atomic<std::uint64_t> logged {0};
+    std::atomic<std::uint64_t> suppressed {0};
+    std::atomic<std::uint64_t> summaries {0};
+};
+
+ThrottleRegistry& throttleRegistry()
+{
+    static ThrottleRegistry r;
+    return r;
+}
+
+// Take the last message of entry
+ThrottleSummary makeSummary(const ThrottleKey& key, ThrottleEntry& entry, Clock::time_point now)
+{
+    ThrottleSummary summary {const_cast<Logger::Log*>(key.log), key.site, key.object, entry.level, entry.suppressed,
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.windowStart).count(), {}};
+    summary.message.swap(entry.lastMessage);
+    return summary;
+}
+
+ThrottleShard& shardOf(ThrottleRegistry& r, const ThrottleKey& key)
+{
+    return r.shards[ThrottleKeyHash()(key) % ThrottleRegistry::shardCount];
+}
+
+// Summarize expired windows, and forget keys that were quiet for a whole window. Call with shard mutex locked.
+void sweep(ThrottleShard& shard, Clock::time_point now, Clock::duration period, std::vector<ThrottleSummary>& summaries)
+{
+    auto it = shard.entries.begin();
+    while(it != shard.entries.end())
+    {
+        auto& entry = it->second;
+        if(now - entry.windowStart < period)
+        {
+            ++it;
+        }
+        else if(entry.suppressed)
+        {
+            summaries.push_back(makeSummary(it->first, entry, now));
+            entry.suppressed = 0;
+            entry.windowStart = now;
+            ++it;
+        }
+        else
+        {
+            it = shard.entries.erase(it);
+        }
+    }
+    shard.lastSweep = now;
+}
+
+// Log outside of the registry lock, sinks can be slow
+void logSummaries(ThrottleRegistry& r, const std::vector<ThrottleSummary>& summaries)
+{
+    for(const auto& s: summaries)
+    {
+        r.summaries++;
+        s.log->log(s.level, "[{}] Suppressed {} times in {} ms, last : {}", s.object, s.suppressed, s.elapsed,
+            s.message.empty() ? std::string(s.site) : s.message);
+    }
+}
+
+void removeSink(const Logger::LogPtr& log, const Logger::SinkPtr& sink)
+{
+    auto& sinks = log->sinks();
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+}
+
+}
+
 // ───── CLASS ─────
 
 void Logger::registerSink(const SinkPtr& sink)
 {
-    for(const auto& it: LOGGERS) it->sinks().emplace_back(sink);
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    r.sinks.push_back(sink);
+    if(r.async)
+        r.async->addSink(sink);
+    else
+        for(const auto& it: LOGGERS) it->sinks().emplace_back(sink);
 }
 
 void Logger::unRegisterSink(const SinkPtr& sink)
 {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    r.sinks.erase(std::remove(r.sinks.begin(), r.sinks.end(), sink), r.sinks.end());
+    if(r.async)
+        r.async->removeSink(sink);
+    for(const auto& it: LOGGERS) removeSink(it, sink);
+}
+
+void Logger::enableAsync(std::size_t queueSize, OverflowPolicy policy)
+{
+    disableAsync();
+
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    r.async = std::make_shared<AsyncLogSink>(queueSize, policy);
+    for(const auto& sink: r.sinks) r.async->addSink(sink);
+
     for(const auto& it: LOGGERS)
     {
-        auto& sinks = it->sinks();
+        for(const auto& sink: r.sinks) removeSink(it, sink);
+        it->sinks().emplace_back(r.async);
+    }
+}
+
+void Logger::disableAsync()
+{
+    std::shared_ptr<AsyncLogSink> async;
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if(!r.async)
+            return;
+
+        for(const auto& it: LOGGERS)
+        {
+            removeSink(it, r.async);
+            for(const auto& sink: r.sinks) it->sinks().emplace_back(sink);
+        }
+        async = std::move(r.async);
+    }
+
+    // Drain the queue and join the background thread outside of the lock
+    async->flush();
+}
+
+bool Logger::isAsync()
+{
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.async != nullptr;
+}
+
+Logger::AsyncStats Logger::asyncStats()
+{
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.async ? r.async->stats() : AsyncStats();
+}
+
+void Logger::flush()
+{
+    std::shared_ptr<AsyncLogSink> async;
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        async = r.async;
+    }
+
+    if(async)
+        async->flush();
+    else
+        for(const auto& it: LOGGERS) it->flush();
+}
+
+bool Logger::throttle(
+    Log* log, const char* site, const void* object, spdlog::level::level_enum level, std::uint64_t variant)
+{
+    auto& r = throttleRegistry();
+    const auto periodMs = r.period.load(std::memory_order_relaxed);
+    if(periodMs <= 0)
+    {
+        r.logged++;
+        return true;
+    }
+
+    const auto period = std::chrono::milliseconds(periodMs);
+    const auto now = Clock::now();
+    std::vector<ThrottleSummary> summaries;
+    bool pass = false;
+    {
+        const ThrottleKey key {log, site, object, variant};
+        auto& shard = shardOf(r, key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        auto sinkIt = sinks.begin();
-        while(sinkIt != sinks.end())
+        auto it = shard.entries.find(key);
+        if(it == shard.entries.end())
         {
-            const auto& s = *sinkIt;
-            if(s == sink)
+            it = shard.entries.emplace(key, ThrottleEntry()).first;
+            it->second.windowStart = now;
+            pass = true;
+        }
+        else if(now - it->second.windowStart >= period)
+        {
+            if(it->second.suppressed)
+                summaries.push_back(makeSummary(key, it->second, now));
+            it->second.suppressed = 0;
+            it->second.windowStart = now;
+            pass = true;
+        }
+        else
+        {
+            ++it->second.suppressed;
+        }
+        it->second.level = level;
+
+        if(now - shard.lastSweep >= period)
+            sweep(shard, now, period, summaries);
+    }
+
+    if(pass)
+        r.logged++;
+    else
+        r.suppressed++;
+
+    logSummaries(r, summaries);
+    return pass;
+}
+
+void Logger::setSuppressedMessage(
+    Log* log, const char* site, const void* object, std::uint64_t variant, std::string message)
+{
+    const ThrottleKey key {log, site, object, variant};
+    auto& shard = shardOf(throttleRegistry(), key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Swept since throttle() suppressed it
+    const auto it = shard.entries.find(key);
+    if(it != shard.entries.end() && it->second.suppressed)
+        it->second.lastMessage = std::move(message);
+}
+
+void Logger::forgetThrottled(const void* object)
+{
+    auto& r = throttleRegistry();
+    std::vector<ThrottleSummary> summaries;
+    const auto now = Clock::now();
+    for(auto& shard: r.shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.begin();
+        while(it != shard.entries.end())
+        {
+            if(it->first.object != object)
             {
-                sinks.erase(sinkIt);
-                break;
+                ++it;
+                continue;
             }
+            if(it->second.suppressed)
+                summaries.push_back(makeSummary(it->first, it->second, now));
+            it = shard.entries.erase(it);
         }
     }
+    logSummaries(r, summaries);
+}
+
+void Logger::setThrottlePeriod(int period) { throttleRegistry().period.store(period); }
+
+int Logger::throttlePeriod() { return throttleRegistry().period.load(); }
+
+Logger::ThrottleStats Logger::throttleStats()
+{
+    auto& r = throttleRegistry();
+    ThrottleStats stats;
+    stats.logged = r.logged.load();
+    stats.suppressed = r.suppressed.load();
+    stats.summaries = r.summaries.load();
+
+    for(auto& shard: r.shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.keys += shard.entries.size();
+    }
+    return stats;
+}
+
+void Logger::flushThrottled()
+{
+    auto& r = throttleRegistry();
+    std::vector<ThrottleSummary> summaries;
+    const auto now = Clock::now();
+    for(auto& shard: r.shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        // Every window is considered expired
+        sweep(shard, now, Clock::duration::zero(), summaries);
+    }
+    logSummaries(r, summaries);
 }
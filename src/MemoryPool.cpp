@@ -0,0 +1,311 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/MemoryPool.hpp>
+
+// Stl Headers
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+const std::size_t MemoryPool::minBlockSize;
+const std::size_t MemoryPool::maxBlockSize;
+const std::size_t MemoryPool::classCount;
+
+// Blocks a thread keeps for itself per size class, half of it move to the depot when full
+static const std::size_t threadCacheSize = 64;
+// Blocks moved at once from the depot to an empty thread cache
+static const std::size_t refillCount = 16;
+
+static std::size_t classSize(std::size_t sizeClass) { return MemoryPool::minBlockSize << sizeClass; }
+
+// Trivially destructible, so still valid while other thread_local objects are destroyed after the cache
+static thread_local bool threadCacheDestroyed = false;
+
+// ───── CLASS ─────
+
+struct MemoryPool::ThreadCache
+{
+    Block* heads[classCount] = {};
+    std::size_t counts[classCount] = {};
+
+    // Thread exit, blocks might still be used by other threads
+    ~ThreadCache()
+    {
+        threadCacheDestroyed = true;
+        auto& pool = MemoryPool::instance();
+        for(std::size_t c = 0; c < classCount; ++c)
+        {
+            if(heads[c])
+                pool.giveToDepot(c, heads[c]);
+        }
+    }
+};
+
+MemoryPool& MemoryPool::instance()
+{
+    static auto* pool = new MemoryPool;
+    return *pool;
+}
+
+MemoryPool::ThreadCache* MemoryPool::threadCache()
+{
+    if(threadCacheDestroyed)
+        return nullptr;
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+std::size_t MemoryPool::classOf(std::size_t size)
+{
+    std::size_t c = 0;
+    while(classSize(c) < size) ++c;
+    return c;
+}
+
+std::size_t MemoryPool::blockSize(std::size_t size) { return size > maxBlockSize ? size : classSize(classOf(size)); }
+
+std::size_t MemoryPool::takeFromDepot(std::size_t sizeClass, Block*& list, std::size_t count)
+{
+    auto& depot = _depots[sizeClass];
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    std::size_t taken = 0;
+    while(depot.head && taken < count)
+    {
+        auto* block = depot.head;
+        depot.head = block->next;
+        block->next = list;
+        list = block;
+        ++taken;
+    }
+    depot.count -= taken;
+    return taken;
+}
+
+void MemoryPool::giveToDepot(std::size_t sizeClass, Block* list)
+{
+    const auto maxCount = _maxCachedBytesPerClass.load(std::memory_order_relaxed) / classSize(sizeClass);
+    auto& depot = _depots[sizeClass];
+
+    Block* release = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        while(list)
+        {
+            auto* block = list;
+            list = block->next;
+            if(depot.count < maxCount)
+            {
+                block->next = depot.head;
+                depot.head = block;
+                ++depot.count;
+            }
+            else
+            {
+                block->next = release;
+                release = block;
+            }
+        }
+    }
+
+    // Free outside of the lock
+    while(release)
+    {
+        auto* block = release;
+        release = block->next;
+        _cachedBytes.fetch_sub(std::int64_t(classSize(sizeClass)), std::memory_order_relaxed);
+        ::operator delete(block);
+    }
+}
+
+void* MemoryPool::allocate(std::size_t size)
+{
+    if(size > maxBlockSize)
+    {
+        _oversized.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    const auto c = classOf(size);
+    auto* cache = threadCache();
+    if(!cache)
+    {
+        Block* block = nullptr;
+        if(takeFromDepot(c, block, 1))
+        {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            _cachedBytes.fetch_sub(std::int64_t(classSize(c)), std::memory_order_relaxed);
+            return block;
+        }
+    }
+    else
+    {
+        if(!cache->heads[c])
+            cache->counts[c] += takeFromDepot(c, cache->heads[c], refillCount);
+    }
+
+    if(auto* block = cache ? cache->heads[c] : nullptr)
+    {
+        cache->heads[c] = block->next;
+        --cache->counts[c];
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        _cachedBytes.fetch_sub(std::int64_t(classSize(c)), std::memory_order_relaxed);
+        return block;
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(classSize(c));
+}
+
+void MemoryPool::deallocate(void* p, std::size_t size)
+{
+    if(!p)
+        return;
+
+    if(size > maxBlockSize)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    const auto c = classOf(size);
+    auto* block = static_cast<Block*>(p);
+    _cachedBytes.fetch_add(std::int64_t(classSize(c)), std::memory_order_relaxed);
+
+    auto* cache = threadCache();
+    if(!cache)
+    {
+        block->next = nullptr;
+        giveToDepot(c, block);
+        return;
+    }
+
+    block->next = cache->heads[c];
+    cache->heads[c] = block;
+    ++cache->counts[c];
+
+    if(cache->counts[c] >= threadCacheSize)
+    {
+        // Keep half for the next allocations of this thread
+        Block* list = nullptr;
+        std::size_t moved = 0;
+        while(moved < threadCacheSize / 2)
+        {
+            auto* b = cache->heads[c];
+            cache->heads[c] = b->next;
+            b->next = list;
+            list = b;
+            ++moved;
+        }
+        cache->counts[c] -= moved;
+        giveToDepot(c, list);
+    }
+}
+
+MemoryPool::Stats MemoryPool::stats() const
+{
+    Stats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.oversized = _oversized.load(std::memory_order_relaxed);
+    stats.cachedBytes = std::uint64_t(std::max<std::int64_t>(_cachedBytes.load(std::memory_order_relaxed), 0));
+    return stats;
+}
+
+void MemoryPool::setMaxCachedBytesPerClass(std::size_t bytes) { _maxCachedBytesPerClass.store(bytes); }
+
+std::size_t MemoryPool::maxCachedBytesPerClass() const { return _maxCachedBytesPerClass.load(); }
+
+void MemoryPool::trim()
+{
+    for(std::size_t c = 0; c < classCount; ++c)
+    {
+        Block* list = nullptr;
+        {
+            auto& depot = _depots[c];
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            list = depot.head;
+            depot.head = nullptr;
+            depot.count = 0;
+        }
+        while(list)
+        {
+            auto* block = list;
+            list = block->next;
+            _cachedBytes.fetch_sub(std::int64_t(classSize(c)), std::memory_order_relaxed);
+            ::operator delete(block);
+        }
+    }
+}
+
+PooledBuffer::PooledBuffer(std::size_t capacity) { reserve(capacity); }
+
+PooledBuffer::~PooledBuffer() { release(); }
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept :
+    _data(other._data), _size(other._size), _capacity(other._capacity)
+{
+    other._data = nullptr;
+    other._size = 0;
+    other._capacity = 0;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+{
+    if(this != &other)
+    {
+        release();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+    return *this;
+}
+
+void PooledBuffer::reserve(std::size_t capacity)
+{
+    if(capacity <= _capacity)
+        return;
+
+    // Use the whole block, next reserve might not need a new one
+    const auto blockSize = MemoryPool::blockSize(capacity);
+    auto* data = static_cast<std::uint8_t*>(MemoryPool::instance().allocate(blockSize));
+    if(_size)
+        std::memcpy(data, _data, _size);
+
+    const auto size = _size;
+    release();
+    _data = data;
+    _size = size;
+    _capacity = blockSize;
+}
+
+void PooledBuffer::resize(std::size_t size)
+{
+    reserve(size);
+    _size = size;
+}
+
+void PooledBuffer::append(const void* data, std::size_t length)
+{
+    if(!length)
+        return;
+    if(_size + length > _capacity)
+        reserve(std::max(_size + length, _capacity * 2));
+    std::memcpy(_data + _size, data, length);
+    _size += length;
+}
+
+void PooledBuffer::release()
+{
+    if(_data)
+        MemoryPool::instance().deallocate(_data, _capacity);
+    _data = nullptr;
+    _size = 0;
+    _capacity = 0;
+}
@@ -0,0 +1,64 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/ReceiveBuffer.hpp>
+
+// Stl Headers
+#include <algorithm>
+#include <cstring>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+std::uint8_t* ReceiveBuffer::prepare(std::size_t length)
+{
+    const auto used = _storage.size();
+    if(_storage.capacity() - used >= length)
+        return _storage.data() + used;
+
+    // Move data to the front before growing
+    const auto bytes = size();
+    if(_begin)
+    {
+        if(bytes)
+            std::memmove(_storage.data(), _storage.data() + _begin, bytes);
+        _storage.resize(bytes);
+        _begin = 0;
+    }
+    if(_storage.capacity() - bytes < length)
+        _storage.reserve(std::max(bytes + length, _storage.capacity() * 2));
+    return _storage.data() + bytes;
+}
+
+void ReceiveBuffer::commit(std::size_t length)
+{
+    _storage.resize(_storage.size() + length);
+}
+
+void ReceiveBuffer::consume(std::size_t length)
+{
+    _begin += std::min(length, size());
+    // Next bytes go to the front, without moving anything
+    if(isEmpty())
+        clear();
+}
+
+void ReceiveBuffer::clear()
+{
+    _storage.clear();
+    _begin = 0;
+}
+
+std::size_t ReceiveBuffer::release()
+{
+    if(!isEmpty())
+        return 0;
+
+    const auto released = _storage.capacity();
+    _storage.release();
+    _begin = 0;
+    return released;
+}
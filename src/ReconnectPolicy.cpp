@@ -0,0 +1,85 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/ReconnectPolicy.hpp>
+
+// Stl Headers
+#include <algorithm>
+#include <limits>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+ReconnectPolicy::ReconnectPolicy(std::uint64_t initialDelay, double multiplier, std::uint64_t maxDelay, Jitter jitter) :
+    _initialDelay(initialDelay), _multiplier(std::max(multiplier, 1.)), _maxDelay(maxDelay), _jitter(jitter),
+    _random(std::random_device {}())
+{
+    reset();
+}
+
+double ReconnectPolicy::limit() const
+{
+    return _maxDelay ? double(std::max(_maxDelay, _initialDelay)) : double(std::numeric_limits<std::uint32_t>::max());
+}
+
+std::uint64_t ReconnectPolicy::random(std::uint64_t min, std::uint64_t max)
+{
+    if(max <= min)
+        return min;
+    return std::uniform_int_distribution<std::uint64_t>(min, max)(_random);
+}
+
+std::uint64_t ReconnectPolicy::nextDelay()
+{
+    const auto cap = limit();
+    std::uint64_t delay = 0;
+
+    switch(_jitter)
+    {
+    case Jitter::None: delay = std::uint64_t(_backoff); break;
+    case Jitter::Full: delay = random(0, std::uint64_t(_backoff)); break;
+    case Jitter::Decorrelated:
+        delay = std::uint64_t(std::min(cap, double(random(_initialDelay, std::uint64_t(_previous * 3)))));
+        break;
+    }
+
+    ++_attempts;
+    // Stop growing once capped, to avoid overflow
+    _backoff = std::min(_backoff * _multiplier, cap);
+    _previous = double(std::max(delay, _initialDelay));
+    return delay;
+}
+
+void ReconnectPolicy::reset()
+{
+    _attempts = 0;
+    _backoff = std::min(double(_initialDelay), limit());
+    _previous = double(_initialDelay);
+}
+
+void ReconnectPolicy::setInitialDelay(std::uint64_t value)
+{
+    _initialDelay = value;
+    reset();
+}
+
+void ReconnectPolicy::setMultiplier(double value)
+{
+    _multiplier = std::max(value, 1.);
+    reset();
+}
+
+void ReconnectPolicy::setMaxDelay(std::uint64_t value)
+{
+    _maxDelay = value;
+    reset();
+}
+
+void ReconnectPolicy::setJitter(Jitter value)
+{
+    _jitter = value;
+    reset();
+}
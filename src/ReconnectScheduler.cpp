@@ -0,0 +1,91 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/ReconnectScheduler.hpp>
+
+// Stl Headers
+#include <algorithm>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+ReconnectScheduler& ReconnectScheduler::instance()
+{
+    // Never destroyed, workers might release their slot during static destruction
+    static auto* scheduler = new ReconnectScheduler;
+    return *scheduler;
+}
+
+void ReconnectScheduler::setMaxConcurrentConnects(int value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxConcurrentConnects = std::max(value, 0);
+    grantWaiters();
+}
+
+int ReconnectScheduler::maxConcurrentConnects() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _maxConcurrentConnects;
+}
+
+bool ReconnectScheduler::isEnabled() const { return maxConcurrentConnects() > 0; }
+
+ReconnectScheduler::Ticket ReconnectScheduler::acquire(QObject* context, Callback granted)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto ticket = _nextTicket++;
+    if(!_maxConcurrentConnects || int(_granted.size()) < _maxConcurrentConnects)
+        grant(ticket, context, std::move(granted));
+    else
+        _waiting.push_back({ticket, context, std::move(granted)});
+    return ticket;
+}
+
+void ReconnectScheduler::release(Ticket ticket)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(_granted.erase(ticket))
+    {
+        grantWaiters();
+        return;
+    }
+
+    const auto it = std::find_if(
+        _waiting.begin(), _waiting.end(), [ticket](const Waiter& waiter) { return waiter.ticket == ticket; });
+    if(it != _waiting.end())
+        _waiting.erase(it);
+}
+
+int ReconnectScheduler::inFlight() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return int(_granted.size());
+}
+
+int ReconnectScheduler::waiting() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return int(_waiting.size());
+}
+
+void ReconnectScheduler::grant(Ticket ticket, QObject* context, Callback granted)
+{
+    _granted.insert(ticket);
+    // context can't be destroyed while locked : it release its ticket first.
+    // Qt drop the queued call if context is destroyed before it runs
+    QMetaObject::invokeMethod(context, [ticket, granted]() { granted(ticket); }, Qt::QueuedConnection);
+}
+
+void ReconnectScheduler::grantWaiters()
+{
+    while(!_waiting.empty() && (!_maxConcurrentConnects || int(_granted.size()) < _maxConcurrentConnects))
+    {
+        auto waiter = std::move(_waiting.front());
+        _waiting.pop_front();
+        grant(waiter.ticket, waiter.context, std::move(waiter.granted));
+    }
+}
@@ -0,0 +1,22 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/RpcReply.hpp>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+RpcReply::RpcReply(quint64 id, QObject* parent) : QObject(parent), _id(id) {}
+
+void RpcReply::finish(Status status, const QByteArray& payload)
+{
+    if(isFinished())
+        return;
+
+    _status = status;
+    _payload = payload;
+    Q_EMIT finished();
+}
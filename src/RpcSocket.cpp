@@ -0,0 +1,111 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/RpcSocket.hpp>
+#include <Net/Tcp/RpcSocketWorker.hpp>
+#include <Net/Tcp/Logger.hpp>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// clang-format off
+#ifdef NDEBUG
+# define LOG_DEV_WARN(str, ...)  do {} while (0)
+#else
+# define LOG_DEV_WARN(str, ...)  NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#endif
+// clang-format on
+
+// ───── CLASS ─────
+
+RpcSocket::RpcSocket(QObject* parent) : Socket(parent) {}
+
+RpcSocket::~RpcSocket()
+{
+    // Without worker thread, ~Socket stop the worker that would call onRequestFinished on a destroyed RpcSocket
+    if(worker())
+        disconnect(worker(), nullptr, this, nullptr);
+}
+
+bool RpcSocket::stop()
+{
+    const auto stopped = Socket::stop();
+    abortPendingReplies();
+    return stopped;
+}
+
+RpcReply* RpcSocket::request(const QByteArray& payload) { return request(payload, requestTimeout()); }
+
+RpcReply* RpcSocket::request(const QByteArray& payload, quint64 timeout)
+{
+    const auto id = _nextRequestId++;
+    auto* reply = new RpcReply(id, this);
+
+    auto* worker = static_cast<RpcSocketWorker*>(this->worker());
+    if(!worker || !isRunning())
+    {
+        LOG_DEV_WARN("Can't send request {}, socket isn't running", id);
+        // Queued so the caller can connect to finished
+        QMetaObject::invokeMethod(
+            reply, [reply]() { reply->finish(RpcReply::Status::Aborted, {}); }, Qt::QueuedConnection);
+        return reply;
+    }
+
+    _pendingReplies.insert(id, reply);
+    setPendingRequests(_pendingReplies.size());
+    QMetaObject::invokeMethod(worker, [worker, id, payload, timeout]() { worker->sendRequest(id, payload, timeout); });
+    return reply;
+}
+
+bool RpcSocket::reply(quint64 id, const QByteArray& payload)
+{
+    auto* worker = static_cast<RpcSocketWorker*>(this->worker());
+    if(!worker || !isRunning())
+        return false;
+
+    QMetaObject::invokeMethod(worker, [worker, id, payload]() { worker->sendResponse(id, payload); });
+    return true;
+}
+
+SocketWorker* RpcSocket::createWorker()
+{
+    auto* worker = createRpcWorker();
+    if(!worker)
+        return nullptr;
+
+    connect(worker, &RpcSocketWorker::requestFinished, this, &RpcSocket::onRequestFinished);
+    connect(worker, &RpcSocketWorker::requestReceived, this, &RpcSocket::requestReceived);
+    return worker;
+}
+
+RpcSocketWorker* RpcSocket::createRpcWorker() { return new RpcSocketWorker; }
+
+void RpcSocket::onRequestFinished(quint64 id, int status, const QByteArray& payload)
+{
+    // Already aborted by stop
+    const auto it = _pendingReplies.find(id);
+    if(it == _pendingReplies.end())
+        return;
+
+    const auto reply = it.value();
+    _pendingReplies.erase(it);
+    setPendingRequests(_pendingReplies.size());
+    if(reply)
+        reply->finish(RpcReply::Status(status), payload);
+}
+
+void RpcSocket::abortPendingReplies()
+{
+    if(_pendingReplies.isEmpty())
+        return;
+
+    const auto replies = std::move(_pendingReplies);
+    _pendingReplies.clear();
+    resetPendingRequests();
+    for(const auto& reply: replies)
+    {
+        if(reply)
+            reply->finish(RpcReply::Status::Aborted, {});
+    }
+}
@@ -0,0 +1,118 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/RpcSocketWorker.hpp>
+#include <Net/Tcp/RpcReply.hpp>
+#include <Net/Tcp/Logger.hpp>
+
+// Qt Headers
+#include <QtCore/QtEndian>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// clang-format off
+#ifdef NDEBUG
+# define LOG_DEV_DEBUG(str, ...) do {} while (0)
+#else
+# define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#endif
+
+#define LOG_ERR_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::err, this, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+// clang-format on
+
+// ───── CLASS ─────
+
+const int RpcSocketWorker::messageHeaderSize;
+
+RpcSocketWorker::RpcSocketWorker(QObject* parent) : FramedSocketWorker(parent) {}
+
+void RpcSocketWorker::sendRequest(quint64 id, const QByteArray& payload, quint64 timeout)
+{
+    if(!writeMessage(MessageType::Request, id, payload))
+    {
+        Q_EMIT requestFinished(id, int(RpcReply::Status::Aborted), {});
+        return;
+    }
+
+    auto& pending = _pendingRequests[id];
+    if(timeout)
+        pending.timerId = TimerWheel::instance()->start(int(timeout), this, [this, id]() { onRequestTimeout(id); });
+}
+
+void RpcSocketWorker::sendResponse(quint64 id, const QByteArray& payload)
+{
+    if(!writeMessage(MessageType::Response, id, payload))
+        LOG_DEV_DEBUG("Drop response {}, socket isn't connected", id);
+}
+
+bool RpcSocketWorker::writeMessage(MessageType type, quint64 id, const QByteArray& payload)
+{
+    QByteArray frame(messageHeaderSize + payload.size(), Qt::Uninitialized);
+    frame[0] = char(type);
+    qToBigEndian(id, frame.data() + 1);
+    std::copy(payload.constBegin(), payload.constEnd(), frame.begin() + messageHeaderSize);
+    return writeFrame(frame);
+}
+
+void RpcSocketWorker::onFrameReceived(const QByteArray& payload)
+{
+    if(payload.size() < messageHeaderSize)
+    {
+        LOG_ERR_THROTTLED("Drop rpc frame of {} bytes, too small for a message header", payload.size());
+        return;
+    }
+
+    const auto type = MessageType(payload.at(0));
+    const auto id = qFromBigEndian<quint64>(payload.constData() + 1);
+    const auto body = payload.mid(messageHeaderSize);
+
+    switch(type)
+    {
+    case MessageType::Request: Q_EMIT requestReceived(id, body); break;
+    case MessageType::Response:
+    {
+        const auto it = _pendingRequests.find(id);
+        // Response that arrived after its deadline
+        if(it == _pendingRequests.end())
+        {
+            LOG_DEV_DEBUG("Drop response {} of unknown request", id);
+            return;
+        }
+        if(it->second.timerId)
+            TimerWheel::instance()->stop(it->second.timerId);
+        _pendingRequests.erase(it);
+        Q_EMIT requestFinished(id, int(RpcReply::Status::Finished), body);
+        break;
+    }
+    default: LOG_ERR_THROTTLED("Drop rpc frame with unknown message type {}", int(type)); break;
+    }
+}
+
+void RpcSocketWorker::onDisconnected()
+{
+    abortPendingRequests();
+    FramedSocketWorker::onDisconnected();
+}
+
+void RpcSocketWorker::onRequestTimeout(quint64 id)
+{
+    if(!_pendingRequests.erase(id))
+        return;
+    Q_EMIT requestFinished(id, int(RpcReply::Status::TimedOut), {});
+}
+
+void RpcSocketWorker::abortPendingRequests()
+{
+    // Responses can't come from the next connection.
+    // Swapped first : without worker thread, a finished handler can send a new request directly
+    std::unordered_map<quint64, PendingRequest> aborted;
+    aborted.swap(_pendingRequests);
+    for(const auto& pending: aborted)
+    {
+        if(pending.second.timerId)
+            TimerWheel::instance()->stop(pending.second.timerId);
+        Q_EMIT requestFinished(pending.first, int(RpcReply::Status::Aborted), {});
+    }
+}
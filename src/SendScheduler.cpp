@@ -0,0 +1,157 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/SendScheduler.hpp>
+
+// Stl Headers
+#include <algorithm>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+SendScheduler::SendScheduler(int laneCount, Policy policy, int chunkSize) :
+    _lanes(std::size_t(std::max(laneCount, 1))), _policy(policy), _chunkSize(std::max(chunkSize, 1))
+{
+}
+
+void SendScheduler::enqueue(int lane, const QByteArray& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lanes[std::size_t(clampLane(lane))].messages.push_back(message);
+    _queuedBytes += std::size_t(message.size());
+}
+
+bool SendScheduler::next(Chunk& chunk)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto lane = pickLane();
+    if(lane < 0)
+        return false;
+
+    chunk = takeChunk(lane);
+    return true;
+}
+
+bool SendScheduler::isEmpty() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::all_of(_lanes.begin(), _lanes.end(), [](const Lane& lane) { return lane.messages.empty(); });
+}
+
+std::size_t SendScheduler::queuedBytes() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queuedBytes;
+}
+
+void SendScheduler::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(auto& lane: _lanes)
+    {
+        lane.messages.clear();
+        lane.offset = 0;
+        lane.credit = lane.weight;
+    }
+    _current = 0;
+    _queuedBytes = 0;
+}
+
+SendScheduler::Policy SendScheduler::policy() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _policy;
+}
+
+void SendScheduler::setPolicy(Policy value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _policy = value;
+}
+
+int SendScheduler::weight(int lane) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _lanes[std::size_t(clampLane(lane))].weight;
+}
+
+void SendScheduler::setWeight(int lane, int value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& l = _lanes[std::size_t(clampLane(lane))];
+    l.weight = std::max(value, 1);
+    l.credit = l.weight;
+}
+
+int SendScheduler::chunkSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _chunkSize;
+}
+
+void SendScheduler::setChunkSize(int value)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _chunkSize = std::max(value, 1);
+}
+
+int SendScheduler::clampLane(int lane) const { return std::min(std::max(lane, 0), int(_lanes.size()) - 1); }
+
+int SendScheduler::pickLane()
+{
+    if(_policy == Policy::StrictPriority)
+    {
+        for(std::size_t i = 0; i < _lanes.size(); ++i)
+        {
+            if(!_lanes[i].messages.empty())
+                return int(i);
+        }
+        return -1;
+    }
+
+    // Lanes get their credit back when the round move past them,
+    // so one turn of the wheel and one more lane is enough to find any non empty lane
+    for(std::size_t i = 0; i <= _lanes.size(); ++i)
+    {
+        auto& lane = _lanes[std::size_t(_current)];
+        if(!lane.messages.empty() && lane.credit > 0)
+        {
+            --lane.credit;
+            return _current;
+        }
+        lane.credit = lane.weight;
+        _current = (_current + 1) % int(_lanes.size());
+    }
+    return -1;
+}
+
+SendScheduler::Chunk SendScheduler::takeChunk(int index)
+{
+    auto& lane = _lanes[std::size_t(index)];
+    auto& message = lane.messages.front();
+
+    Chunk chunk;
+    chunk.lane = index;
+    if(!lane.offset && message.size() <= _chunkSize)
+    {
+        // Small messages aren't copied
+        chunk.data = std::move(message);
+    }
+    else
+    {
+        chunk.data = message.mid(lane.offset, _chunkSize);
+        lane.offset += chunk.data.size();
+        chunk.more = lane.offset < message.size();
+    }
+    _queuedBytes -= std::size_t(chunk.data.size());
+
+    if(!chunk.more)
+    {
+        lane.messages.pop_front();
+        lane.offset = 0;
+    }
+    return chunk;
+}
@@ -4,12 +4,25 @@
 #include <Net/Tcp/Server.hpp>
 #include <Net/Tcp/ServerWorker.hpp>
 #include <Net/Tcp/Socket.hpp>
+#include <Net/Tcp/SocketWorker.hpp>
+#include <Net/Tcp/EventLoopMonitor.hpp>
 #include <Net/Tcp/Logger.hpp>
+#include <Net/Tcp/TokenBucket.hpp>
+#include <Net/Tcp/Trace.hpp>
+#include <Net/Tcp/TrafficRecorder.hpp>
 
 // Qt Headers
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QTcpSocket>
 
+// Stl Headers
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 // ───── DECLARATION ─────
 
 using namespace net::tcp;
@@ -18,39 +31,59 @@ using namespace net::tcp;
 #ifdef NDEBUG
 #define LOG_DEV_DEBUG(str, ...) do {} while (0)
 #else
-#define LOG_DEV_DEBUG(str, ...) Logger::SERVER->debug("[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*) (this), ##__VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 #define LOG_DEV_INFO(str, ...) do {} while (0)
 #else
-#define LOG_DEV_INFO(str, ...) Logger::SERVER->info("[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_DEV_INFO(str, ...) NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*) (this), ##__VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 #define LOG_DEV_WARN(str, ...) do {} while (0)
 #else
-#define LOG_DEV_WARN(str, ...) Logger::SERVER->warn("[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_DEV_WARN(str, ...) NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*) (this), ##__VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 #define LOG_DEV_ERR(str, ...) do {} while (0)
 #else
-#define LOG_DEV_ERR(str, ...) Logger::SERVER->error("[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_DEV_ERR(str, ...) NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*) (this), ##__VA_ARGS__)
 #endif
 
-#define LOG_DEBUG(str, ...)   Logger::SERVER->debug("[{}] " str, (void*) (this), ##__VA_ARGS__)
-#define LOG_INFO(str, ...)    Logger::SERVER->info( "[{}] " str, (void*) (this), ##__VA_ARGS__)
-#define LOG_WARN(str, ...)    Logger::SERVER->warn( "[{}] " str, (void*) (this), ##__VA_ARGS__)
-#define LOG_ERR(str, ...)     Logger::SERVER->error("[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_DEBUG(str, ...)   NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_INFO(str, ...)    NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_WARN(str, ...)    NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_ERR(str, ...)     NETTCP_LOG(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_INFO_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::info, this, "[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_WARN_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::warn, this, "[{}] " str, (void*) (this), ##__VA_ARGS__)
+#define LOG_ERR_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SERVER, NETTCP_SERVER_LOG_LEVEL, spdlog::level::err, this, "[{}] " str, (void*) (this), ##__VA_ARGS__)
 // clang-format on
 
 // ───── CLASS ─────
 
 Server::Server(QObject* parent) :
-    IServer(parent, {"address", "port", "peerAddress", "peerPort"}), _worker(new ServerWorker(this))
+    IServer(parent, {"address", "port", "peerAddress", "peerPort"}), _worker(new ServerWorker(this)),
+    _rxBucket(std::make_shared<TokenBucket>()), _txBucket(std::make_shared<TokenBucket>())
 {
     _worker->setObjectName("worker");
+    // Buckets are shared with running clients, a new limit apply to them immediately
+    connect(this, &Server::rxRateLimitChanged, this, [this](quint64 value) { _rxBucket->setRate(value); });
+    connect(this, &Server::txRateLimitChanged, this, [this](quint64 value) { _txBucket->setRate(value); });
+    // Clients open the same recorder by path
+    connect(this, &Server::recordPathChanged, this,
+        [this](const QString& path) { _recorder = path.isEmpty() ? nullptr : TrafficRecorder::open(path); });
+    connect(this, &Server::receiveBufferSizeChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::sendBufferSizeChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::keepAliveIdleChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::keepAliveIntervalChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::keepAliveCountChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::userTimeoutChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::quickAckChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::notSentLowWatermarkChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::typeOfServiceChanged, this, &Server::applySocketOptions);
+    connect(this, &Server::socketPriorityChanged, this, &Server::applySocketOptions);
     connect(_worker, &ServerWorker::newIncomingConnection, this,
         [this](qintptr handle)
         {
@@ -61,7 +94,8 @@ Server::Server(QObject* parent) :
                 return;
             }
 
-            LOG_INFO("Incoming new connection detected");
+            NETTCP_TRACE_INSTANT("server", "accept", this, std::uint64_t(handle));
+            LOG_DEBUG("Incoming new connection detected");
 
             if(!canAcceptNewClient())
             {
@@ -69,7 +103,8 @@ Server::Server(QObject* parent) :
                 socket->setSocketDescriptor(handle);
                 const auto peerAddress = socket->peerAddress().toString();
                 const auto peerPort = socket->peerPort();
-                socket->setObjectName(QString("refusing socket %1:%2").arg(peerAddress).arg(peerPort));
+                if(!slimMode())
+                    socket->setObjectName(QString("refusing socket %1:%2").arg(peerAddress).arg(peerPort));
                 LOG_INFO("Refuse connection of client {}:{}", peerAddress.toStdString(), peerPort);
                 Q_EMIT clientRefused(peerAddress, peerPort);
                 socket->close();
@@ -77,10 +112,24 @@ Server::Server(QObject* parent) :
                 return;
             }
 
-            auto* socket = newSocket(this);
-            socket->setObjectName(QString("socket sd%1").arg(handle));
-            socket->setUseWorkerThread(useWorkerThread());
+            auto* socket = takeSocket();
+            if(!slimMode())
+                socket->setObjectName(QString("socket sd%1").arg(handle));
+            socket->setSlimMode(slimMode());
+            socket->setUseWorkerThread(useWorkerThread() && !slimMode());
             socket->setNoDelay(noDelay());
+            socket->setSocketOptions(socketOptions());
+            socket->setReadLowWatermark(readLowWatermark());
+            socket->setReadMaxDelay(readMaxDelay());
+            socket->setReadBudget(readBudget());
+            socket->setMonitorEventLoop(monitorEventLoop());
+            socket->setTcpInfoPeriod(tcpInfoPeriod());
+            socket->setRecordPath(recordPath());
+            socket->setIdleTimeout(idleTimeout());
+            socket->setHeartbeatPeriod(heartbeatPeriod());
+            socket->setHeartbeatMaxMissed(heartbeatMaxMissed());
+            socket->_serverRxBucket = _rxBucket;
+            socket->_serverTxBucket = _txBucket;
 
             connect(socket, &Socket::startFailed, this,
                 [this, socket]()
@@ -93,7 +142,8 @@ Server::Server(QObject* parent) :
                 [this, socket](const QString& address, const quint16 port)
                 {
                     LOG_INFO("Client successful started {}:{}", qPrintable(address), int(port));
-                    socket->setObjectName(QString("refusing socket %1:%2").arg(address).arg(port));
+                    if(!slimMode())
+                        socket->setObjectName(QString("refusing socket %1:%2").arg(address).arg(port));
                     append(socket);
                 });
 
@@ -127,12 +177,31 @@ Server::Server(QObject* parent) :
                         LOG_INFO("Client {}:{} disconnected", socket->peerAddress().toStdString(), socket->peerPort());
                         disconnect(socket, nullptr, this, nullptr);
                         disconnect(this, nullptr, socket, nullptr);
-                        remove(socket);
+                        if(socketPoolSize() > 0)
+                        {
+                            auto* recycled = const_cast<Socket*>(socket);
+                            takeClient(recycled);
+                            recycleSocket(recycled);
+                        }
+                        else
+                        {
+                            remove(socket);
+                        }
                     }
                 });
         });
 
     onRemoved(this, [this](const Socket* socket) { Q_EMIT clientLost(socket->peerAddress(), socket->peerPort()); });
+
+    connect(this, &Server::monitorEventLoopChanged, this, &Server::applyMonitorEventLoop);
+    connect(this, &Server::socketPoolSizeChanged, this, &Server::applySocketPoolSize);
+    // Pooled sockets are prepared for the old thread model
+    connect(this, &Server::slimModeChanged, this,
+        [this]()
+        {
+            clearSocketPool();
+            fillSocketPool();
+        });
 }
 
 // Defined here to avoid #include <QTimer> and <ServerWorker>
@@ -184,8 +253,8 @@ bool Server::tryStart()
     stopWatchdog();
     if(!startWorker())
     {
-        LOG_ERR("Fail to start worker, start watchdog to retry in {} ms. "
-                "Reason : {}",
+        LOG_ERR_THROTTLED("Fail to start worker, start watchdog to retry in {} ms. "
+                          "Reason : {}",
             static_cast<std::uint64_t>(watchdogPeriod()), _worker->errorString().toStdString());
         startWatchdog();
         return false;
@@ -204,6 +273,8 @@ bool Server::startWorker()
     const auto hostAddress = address().isEmpty() ? QHostAddress::Any : QHostAddress(address());
     const auto result = _worker->listen(hostAddress, port());
     setListening(result);
+    if(result)
+        fillSocketPool();
     return result;
 }
 
@@ -217,6 +288,8 @@ bool Server::stopWorker()
         client->stop();
     }
 
+    clearSocketPool();
+
     // Close the server
     if(_worker->isListening())
         _worker->close();
@@ -245,7 +318,7 @@ void Server::startWatchdog()
     }
     else
     {
-        LOG_INFO("Try restart server remaining {} ms", _watchdog->remainingTime());
+        LOG_INFO_THROTTLED("Try restart server remaining {} ms", _watchdog->remainingTime());
     }
     _watchdog->start(watchdogPeriod());
 }
@@ -257,6 +330,117 @@ void Server::stopWatchdog()
     _watchdog = nullptr;
 }
 
+void Server::applyMonitorEventLoop()
+{
+    if(monitorEventLoop())
+    {
+        if(_eventLoopMonitor)
+            return;
+
+        _eventLoopMonitor = EventLoopMonitor::forCurrentThread();
+        connect(_eventLoopMonitor.get(), &EventLoopMonitor::statsUpdated, this,
+            [this](quint64 lag, qreal load, quint64 wakeupsPerSeconds)
+            {
+                setEventLoopLag(lag);
+                setEventLoopLoad(load);
+                setEventLoopWakeupsPerSeconds(wakeupsPerSeconds);
+            });
+    }
+    else if(_eventLoopMonitor)
+    {
+        disconnect(_eventLoopMonitor.get(), nullptr, this, nullptr);
+        _eventLoopMonitor.reset();
+        resetEventLoopLag();
+        resetEventLoopLoad();
+        resetEventLoopWakeupsPerSeconds();
+    }
+}
+
+Socket* Server::takeSocket()
+{
+    if(_socketPool.empty())
+        return newSocket(this);
+
+    auto* socket = _socketPool.back();
+    _socketPool.pop_back();
+
+    // Keep construction out of the accept path
+    if(!_socketPoolRefillPending)
+    {
+        _socketPoolRefillPending = true;
+        QMetaObject::invokeMethod(
+            this,
+            [this]()
+            {
+                _socketPoolRefillPending = false;
+                fillSocketPool();
+            },
+            Qt::QueuedConnection);
+    }
+    return socket;
+}
+
+void Server::takeClient(Socket* socket)
+{
+    // QOlm has no remove without delete : QOlm::remove deletes the object when its parent is the list.
+    // Detaching it first keeps the socket alive for the pool, then the server owns it again.
+    socket->setParent(nullptr);
+    remove(socket);
+    socket->setParent(this);
+}
+
+void Server::recycleSocket(Socket* socket)
+{
+    // Called from the socket disconnection, don't stop its worker in the middle of a worker signal
+    QMetaObject::invokeMethod(
+        this,
+        [this, socket]()
+        {
+            if(!isListening() || int(_socketPool.size()) >= socketPoolSize() || !socket->recycle())
+            {
+                socket->deleteLater();
+                return;
+            }
+            LOG_DEV_DEBUG("Recycle socket {} in pool", static_cast<void*>(socket));
+            _socketPool.push_back(socket);
+        },
+        Qt::QueuedConnection);
+}
+
+void Server::fillSocketPool()
+{
+    while(isListening() && int(_socketPool.size()) < socketPoolSize())
+    {
+        auto* socket = newSocket(this);
+        socket->setSlimMode(slimMode());
+        socket->setUseWorkerThread(useWorkerThread() && !slimMode());
+        if(!socket->prepare())
+        {
+            LOG_ERR("Fail to prepare pooled socket");
+            socket->deleteLater();
+            return;
+        }
+        _socketPool.push_back(socket);
+    }
+}
+
+void Server::clearSocketPool()
+{
+    for(auto* socket: _socketPool) socket->deleteLater();
+    _socketPool.clear();
+}
+
+void Server::applySocketPoolSize()
+{
+    const auto size = std::size_t(std::max(socketPoolSize(), 0));
+    while(_socketPool.size() > size)
+    {
+        _socketPool.back()->deleteLater();
+        _socketPool.pop_back();
+    }
+    fillSocketPool();
+}
+
 Socket* Server::newSocket(QObject* parent) { return new Socket(parent); }
 
 bool Server::start()
@@ -332,4 +516,135 @@ void Server::disconnectFrom(const QString& address, const quint16 port) { remove
 
 void Server::disconnectFrom(const QString& address) { remove(getSockets(address)); }
 
-bool Server::canAcceptNewClient() const { return count() < maxClientCount(); }
+QVariantMap Server::tcpInfoSummary() const
+{
+    struct Sample
+    {
+        quint32 value;
+        const Socket* socket;
+    };
+
+    std::vector<const Socket*> sampled;
+    for(const auto* socket: *this)
+    {
+        // rtt is 0 until the first sample
+        if(socket->isConnected() && socket->tcpRtt())
+            sampled.push_back(socket);
+    }
+
+    const auto summarize = [&sampled](quint32 (Socket::*getter)() const)
+    {
+        QVariantMap summary;
+        if(sampled.empty())
+            return summary;
+
+        std::vector<Sample> samples;
+        samples.reserve(sampled.size());
+        for(const auto* socket: sampled) samples.push_back({(socket->*getter)(), socket});
+        std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) { return a.value < b.value; });
+
+        // Nearest rank percentile
+        const auto percentile = [&samples](double p)
+        {
+            const auto rank = std::size_t(std::ceil(p / 100. * double(samples.size())));
+            return samples[std::max<std::size_t>(rank, 1) - 1].value;
+        };
+
+        summary["p50"] = percentile(50);
+        summary["p90"] = percentile(90);
+        summary["p99"] = percentile(99);
+        summary["max"] = samples.back().value;
+        summary["maxPeer"] =
+            QString("%1:%2").arg(samples.back().socket->peerAddress()).arg(samples.back().socket->peerPort());
+        return summary;
+    };
+
+    QVariantMap summary;
+    summary["count"] = int(sampled.size());
+    summary["rtt"] = summarize(&Socket::tcpRtt);
+    summary["rttVariance"] = summarize(&Socket::tcpRttVariance);
+    summary["congestionWindow"] = summarize(&Socket::tcpCongestionWindow);
+    summary["retransmits"] = summarize(&Socket::tcpRetransmits);
+    summary["unackedSegments"] = summarize(&Socket::tcpUnackedSegments);
+    summary["sendQueueBytes"] = summarize(&Socket::tcpSendQueueBytes);
+    return summary;
+}
+
+SocketOptions Server::socketOptions() const
+{
+    SocketOptions options;
+    options.receiveBufferSize = receiveBufferSize();
+    options.sendBufferSize = sendBufferSize();
+    options.keepAliveIdle = keepAliveIdle();
+    options.keepAliveInterval = keepAliveInterval();
+    options.keepAliveCount = keepAliveCount();
+    options.userTimeout = userTimeout();
+    options.quickAck = quickAck();
+    options.notSentLowWatermark = notSentLowWatermark();
+    options.typeOfService = typeOfService();
+    options.priority = socketPriority();
+    return options;
+}
+
+void Server::applySocketOptions()
+{
+    const auto options = socketOptions();
+    for(auto* socket: *this) socket->setSocketOptions(options);
+}
+
+int Server::broadcast(const QByteArray& data) { return broadcast(data, nullptr); }
+
+int Server::broadcast(const QByteArray& data, const BroadcastFilter& filter)
+{
+    using Workers = std::vector<QPointer<SocketWorker>>;
+
+    // Workers of clients without worker thread all live in the server thread
+    QHash<QThread*, Workers> workersByThread;
+    int clients = 0;
+    for(auto* socket: *this)
+    {
+        if(filter && !filter(socket))
+            continue;
+
+        auto* worker = socket->queueSend(data);
+        if(!worker)
+            continue;
+
+        workersByThread[worker->thread()].emplace_back(worker);
+        ++clients;
+    }
+
+    NETTCP_TRACE_INSTANT("server", "broadcast", this, std::uint64_t(clients));
+    for(auto it = workersByThread.begin(); it != workersByThread.end(); ++it)
+    {
+        // The event is dropped if its context is destroyed. The server outlive the workers of its thread
+        QObject* context = it.key() == thread() ? static_cast<QObject*>(this) : it.value().front().data();
+        Workers workers = std::move(it.value());
+        QMetaObject::invokeMethod(context,
+            [workers, data]()
+            {
+                // QPointer are checked in the thread that delete the workers
+                for(const auto& worker: workers)
+                {
+                    if(worker)
+                        worker->onSendData(data);
+                }
+            });
+    }
+    return clients;
+}
+
+bool Server::canAcceptNewClient() const
+{
+    if(count() >= maxClientCount())
+        return false;
+
+    if(_eventLoopMonitor && maxEventLoopLag() && eventLoopLag() > maxEventLoopLag())
+    {
+        LOG_WARN_THROTTLED(
+            "Event loop lag {} µs is above {} µs, refuse new client", eventLoopLag(), maxEventLoopLag());
+        return false;
+    }
+
+    return true;
+}
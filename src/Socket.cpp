@@ -3,11 +3,15 @@
 // Library Headers
 #include <Net/Tcp/Socket.hpp>
 #include <Net/Tcp/SocketWorker.hpp>
+#include <Net/Tcp/TrafficRecorder.hpp>
 #include <Net/Tcp/Logger.hpp>
 
 // Qt Headers
 #include <QtCore/QThread>
 
+// Stl Headers
+#include <algorithm>
+
 // ───── DECLARATION ─────
 
 using namespace net::tcp;
@@ -17,37 +21,50 @@ using namespace net::tcp;
 #ifdef NDEBUG
 # define LOG_DEV_DEBUG(str, ...) do {} while (0)
 #else
-# define LOG_DEV_DEBUG(str, ...) Logger::SOCKET->debug( "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_INFO(str, ...)  do {} while (0)
 #else
-# define LOG_DEV_INFO(str, ...)  Logger::SOCKET->info(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_INFO(str, ...)  NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_WARN(str, ...)  do {} while (0)
 #else
-# define LOG_DEV_WARN(str, ...)  Logger::SOCKET->warn(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_WARN(str, ...)  NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_ERR(str, ...)   do {} while (0)
 #else
-# define LOG_DEV_ERR(str, ...)   Logger::SOCKET->error( "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_ERR(str, ...)   NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
-#define LOG_DEBUG(str, ...)      Logger::SOCKET->debug( "[{}] " str, (void*)(this), ## __VA_ARGS__)
-#define LOG_INFO(str, ...)       Logger::SOCKET->info(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
-#define LOG_WARN(str, ...)       Logger::SOCKET->warn(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
-#define LOG_ERR(str, ...)        Logger::SOCKET->error( "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_DEBUG(str, ...)      NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_INFO(str, ...)       NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_WARN(str, ...)       NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_ERR(str, ...)        NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 
 // clang-format on
 
 // ───── CLASS ─────
 
-Socket::Socket(QObject* parent) : ISocket(parent) {}
+Socket::Socket(QObject* parent) : ISocket(parent)
+{
+    connect(this, &Socket::receiveBufferSizeChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::sendBufferSizeChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::keepAliveIdleChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::keepAliveIntervalChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::keepAliveCountChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::userTimeoutChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::quickAckChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::notSentLowWatermarkChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::typeOfServiceChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::socketPriorityChanged, this, &Socket::postSocketOptions);
+    connect(this, &Socket::recordPathChanged, this, &Socket::onRecordPathChanged);
+}
 
 Socket::~Socket() { killWorker(); }
 
@@ -97,11 +114,32 @@ bool Socket::setUseWorkerThread(const bool& value)
                 value ? "it use it's own thread now" : "it's not using it's own thread anymore");
             restart();
         }
+        else if(_worker)
+        {
+            // Prepared worker live in the wrong thread
+            killWorker();
+        }
         return true;
     }
     return false;
 }
 
+bool Socket::prepare()
+{
+    if(isRunning() || _worker)
+    {
+        LOG_DEV_WARN("Can't prepare socket that is already running or prepared");
+        return false;
+    }
+
+    if(!setupWorker())
+    {
+        LOG_ERR("Fail to create worker. Please return a valid SocketWorker from Socket::createWorker.");
+        return false;
+    }
+    return true;
+}
+
 bool Socket::start()
 {
     if(isRunning())
@@ -121,18 +159,32 @@ bool Socket::start()
         LOG_INFO("Start tcp socket to {}:{}", qPrintable(peerAddress()), int(peerPort()));
     }
 
+    // Worker might already be prepared
+    if(!_worker && !setupWorker())
+    {
+        LOG_ERR("Fail to create worker. Please return a valid SocketWorker from Socket::createWorker.");
+        stop();
+        return false;
+    }
+
+    configureWorker();
+
+    LOG_INFO("Start worker");
+    Q_EMIT startWorker();
+
+    return true;
+}
+
+bool Socket::setupWorker()
+{
     Q_ASSERT(_worker == nullptr);
     Q_ASSERT(_workerThread == nullptr);
 
     _worker = createWorker();
     if(!_worker)
-    {
-        LOG_ERR("Fail to create worker. Please return a valid SocketWorker from Socket::createWorker.");
-        stop();
         return false;
-    }
 
-    if(_worker->objectName().isEmpty())
+    if(_worker->objectName().isEmpty() && !slimMode())
         _worker->setObjectName("socketWorker");
 
     if(useWorkerThread())
@@ -149,8 +201,10 @@ bool Socket::start()
         {
             if(socketDescriptor())
                 _workerThread->setObjectName("Socket Worker sd" + QString::number(socketDescriptor()));
-            else
+            else if(!peerAddress().isEmpty())
                 _workerThread->setObjectName("Socket Worker " + peerAddress() + ":" + QString::number(peerPort()));
+            else
+                _workerThread->setObjectName("Socket Worker");
         }
     }
     else
@@ -158,42 +212,140 @@ bool Socket::start()
         _worker->setParent(this);
     }
 
-    if(socketDescriptor())
-    {
-        _worker->_socketDescriptor = socketDescriptor();
-    }
-    else
-    {
-        _worker->_address = peerAddress();
-        _worker->_port = peerPort();
-    }
-
-    _worker->_watchdogPeriod = watchdogPeriod();
-    _worker->_noDelay = noDelay();
-
     connect(_worker, &SocketWorker::startSuccess, this, &Socket::onStartSuccess);
     connect(_worker, &SocketWorker::startFailed, this, &Socket::onStartFail);
     connect(_worker, &SocketWorker::connectionChanged, this, &Socket::setConnected);
     connect(_worker, &SocketWorker::socketError, this, &Socket::socketError);
     connect(_worker, &SocketWorker::bytesReceived, this, &Socket::onBytesReceived);
     connect(_worker, &SocketWorker::bytesSent, this, &Socket::onBytesSent);
+    connect(_worker, &SocketWorker::eventLoopStatsUpdated, this, &Socket::onEventLoopStatsUpdated);
+    connect(_worker, &SocketWorker::tcpInfoUpdated, this, &Socket::onTcpInfoUpdated);
+    connect(_worker, &SocketWorker::idleChanged, this, &Socket::setIdle);
+    connect(_worker, &SocketWorker::idleBuffersReleased, this, &Socket::onIdleBuffersReleased);
+    connect(_worker, &SocketWorker::outboundDropped, this, &Socket::onOutboundDropped);
+    connect(_worker, &SocketWorker::conflationUpdated, this, &Socket::onConflationUpdated);
+    connect(_worker, &SocketWorker::throttleChanged, this, &Socket::onThrottleChanged);
+    connect(_worker, &SocketWorker::heartbeatUpdated, this, &Socket::onHeartbeatUpdated);
+    connect(_worker, &SocketWorker::socketOptionsApplied, this, &Socket::setEffectiveSocketOptions);
+    connect(_worker, &SocketWorker::readStatsUpdated, this, &Socket::onReadStatsUpdated);
     connect(this, &Socket::startWorker, _worker, &SocketWorker::onStart);
     if(useWorkerThread())
         connect(this, &Socket::stopWorker, _worker, &SocketWorker::onStop, Qt::BlockingQueuedConnection);
     else
         connect(this, &Socket::stopWorker, _worker, &SocketWorker::onStop, Qt::DirectConnection);
     connect(this, &Socket::watchdogPeriodChanged, _worker, &SocketWorker::onWatchdogPeriodChanged);
+    connect(this, &Socket::reconnectMultiplierChanged, _worker, &SocketWorker::setReconnectMultiplier);
+    connect(this, &Socket::reconnectMaxDelayChanged, _worker, &SocketWorker::setReconnectMaxDelay);
+    connect(this, &Socket::reconnectJitterChanged, _worker, &SocketWorker::setReconnectJitter);
+    connect(this, &Socket::connectTimeoutChanged, _worker, &SocketWorker::setConnectTimeout);
+    connect(this, &Socket::connectAttemptDelayChanged, _worker, &SocketWorker::setConnectAttemptDelay);
+    connect(this, &Socket::outboundQueueSizeChanged, _worker, &SocketWorker::setOutboundQueueSize);
+    connect(this, &Socket::outboundQueueMaxAgeChanged, _worker, &SocketWorker::setOutboundQueueMaxAge);
+    connect(this, &Socket::outboundQueueDropPolicyChanged, _worker, &SocketWorker::setOutboundQueueDropPolicy);
+    connect(this, &Socket::conflationThresholdChanged, _worker, &SocketWorker::setConflationThreshold);
+    connect(this, &Socket::conflationMaxKeysChanged, _worker, &SocketWorker::setConflationMaxKeys);
+    connect(this, &Socket::rxRateLimitChanged, _worker, &SocketWorker::setRxRateLimit);
+    connect(this, &Socket::txRateLimitChanged, _worker, &SocketWorker::setTxRateLimit);
     connect(this, &Socket::noDelayChanged, _worker, &SocketWorker::setNoDelay);
-
+    connect(this, &Socket::monitorEventLoopChanged, _worker, &SocketWorker::setMonitorEventLoop);
+    connect(this, &Socket::tcpInfoPeriodChanged, _worker, &SocketWorker::setTcpInfoPeriod);
+    connect(this, &Socket::idleTimeoutChanged, _worker, &SocketWorker::setIdleTimeout);
+    connect(this, &Socket::heartbeatPeriodChanged, _worker, &SocketWorker::setHeartbeatPeriod);
+    connect(this, &Socket::readLowWatermarkChanged, _worker, &SocketWorker::setReadLowWatermark);
+    connect(this, &Socket::readMaxDelayChanged, _worker, &SocketWorker::setReadMaxDelay);
+    connect(this, &Socket::readBudgetChanged, _worker, &SocketWorker::setReadBudget);
+    connect(this, &Socket::heartbeatMaxMissedChanged, _worker, &SocketWorker::setHeartbeatMaxMissed);
+
+    // The worker thread only wait for events until startWorker is emitted.
     if(_workerThread)
         _workerThread->start();
 
-    LOG_INFO("Start worker");
-    Q_EMIT startWorker();
-
     return true;
 }
 
+void Socket::configureWorker()
+{
+    Q_ASSERT(_worker);
+
+    // A recycled worker is still running in its thread, so the configuration is copied here and applied by the
+    // worker thread. It is queued before startWorker, and events to the same receiver are delivered in order.
+    struct Config
+    {
+        quintptr socketDescriptor;
+        QString address;
+        quint16 port;
+        quint64 watchdogPeriod;
+        ReconnectPolicy reconnectPolicy;
+        bool noDelay;
+        SocketOptions socketOptions;
+        int readLowWatermark;
+        quint64 readMaxDelay;
+        quint64 readBudget;
+        bool slimMode;
+        bool monitorEventLoop;
+        quint64 tcpInfoPeriod;
+        quint64 idleTimeout;
+        quint64 heartbeatPeriod;
+        int heartbeatMaxMissed;
+        quint64 connectTimeout;
+        quint64 connectAttemptDelay;
+        quint64 outboundQueueSize;
+        quint64 outboundQueueMaxAge;
+        int outboundQueueDropPolicy;
+        quint64 conflationThreshold;
+        int conflationMaxKeys;
+        quint64 rxRateLimit;
+        quint64 txRateLimit;
+        std::shared_ptr<TokenBucket> serverRxBucket;
+        std::shared_ptr<TokenBucket> serverTxBucket;
+        std::shared_ptr<TrafficRecorder> recorder;
+    };
+
+    Config config {socketDescriptor(), socketDescriptor() ? QString() : peerAddress(),
+        quint16(socketDescriptor() ? 0 : peerPort()), watchdogPeriod(),
+        ReconnectPolicy(watchdogPeriod(), reconnectMultiplier(), reconnectMaxDelay(),
+            ReconnectPolicy::Jitter(std::min(std::max(reconnectJitter(), 0), 2))),
+        noDelay(), socketOptions(), std::max(readLowWatermark(), 0), readMaxDelay(), readBudget(), slimMode(),
+        monitorEventLoop(), tcpInfoPeriod(), idleTimeout(), heartbeatPeriod(), std::max(heartbeatMaxMissed(), 0),
+        connectTimeout(), connectAttemptDelay(), outboundQueueSize(), outboundQueueMaxAge(), outboundQueueDropPolicy(),
+        conflationThreshold(), conflationMaxKeys(), rxRateLimit(), txRateLimit(), _serverRxBucket, _serverTxBucket,
+        _recorder};
+
+    auto* worker = _worker;
+    QMetaObject::invokeMethod(worker,
+        [worker, config = std::move(config)]()
+        {
+            worker->_socketDescriptor = config.socketDescriptor;
+            worker->_address = config.address;
+            worker->_port = config.port;
+            worker->_watchdogPeriod = config.watchdogPeriod;
+            worker->_reconnectPolicy = config.reconnectPolicy;
+            worker->_noDelay = config.noDelay;
+            worker->_socketOptions = config.socketOptions;
+            worker->_readLowWatermark = config.readLowWatermark;
+            worker->_readMaxDelay = config.readMaxDelay;
+            worker->_readBudget = config.readBudget;
+            worker->_slimMode = config.slimMode;
+            worker->_monitorEventLoop = config.monitorEventLoop;
+            worker->_tcpInfoPeriod = config.tcpInfoPeriod;
+            worker->_idleTimeout = config.idleTimeout;
+            worker->_heartbeatPeriod = config.heartbeatPeriod;
+            worker->_heartbeatMaxMissed = config.heartbeatMaxMissed;
+            worker->_connectTimeout = config.connectTimeout;
+            worker->_connectAttemptDelay = config.connectAttemptDelay;
+            worker->_outboundQueueSize = config.outboundQueueSize;
+            worker->_outboundQueueMaxAge = config.outboundQueueMaxAge;
+            worker->_outboundQueueDropPolicy = config.outboundQueueDropPolicy;
+            worker->_conflationThreshold = config.conflationThreshold;
+            worker->_conflationMaxKeys = config.conflationMaxKeys;
+            worker->_rxBucket.setRate(config.rxRateLimit);
+            worker->_txBucket.setRate(config.txRateLimit);
+            worker->_serverRxBucket = config.serverRxBucket;
+            worker->_serverTxBucket = config.serverTxBucket;
+            worker->_recorder = config.recorder;
+        });
+}
+
 bool Socket::start(quintptr socketDescriptor)
 {
     setSocketDescriptor(socketDescriptor);
@@ -212,6 +364,17 @@ bool Socket::stop()
     killWorker();
     resetTxBytesPerSeconds();
     resetRxBytesPerSeconds();
+    resetEventLoopLag();
+    resetEventLoopLoad();
+    resetEventLoopWakeupsPerSeconds();
+    onTcpInfoUpdated(0, 0, 0, 0, 0, 0);
+    resetIdle();
+    resetRxThrottled();
+    resetTxThrottled();
+    onHeartbeatUpdated(0, 0);
+    resetEffectiveSocketOptions();
+    resetReadDispatchTimeMax();
+    resetReadRequeueLatencyMax();
 
     resetConnected();
     resetRunning();
@@ -219,6 +382,123 @@ bool Socket::stop()
     return true;
 }
 
+bool Socket::recycle()
+{
+    if(!_worker)
+        return false;
+
+    // Worker close its connection but stay alive, in its thread and connected to this socket
+    LOG_DEV_INFO("Recycle Worker [{}]", static_cast<void*>(_worker));
+    Q_EMIT stopWorker();
+
+    resetRunning();
+    resetConnected();
+    resetIdle();
+    resetSocketDescriptor();
+    resetLocalAddress();
+    resetLocalPort();
+    resetTxBytesPerSeconds();
+    resetRxBytesPerSeconds();
+    resetTxBytesTotal();
+    resetRxBytesTotal();
+    resetIdleReclaimedBytes();
+    resetOutboundDroppedCount();
+    resetConflatedCount();
+    resetConflationDroppedCount();
+    resetReadBudgetExceededCount();
+    resetRxThrottled();
+    resetTxThrottled();
+    onHeartbeatUpdated(0, 0);
+    resetEffectiveSocketOptions();
+    resetReadDispatchTimeMax();
+    resetReadRequeueLatencyMax();
+    resetEventLoopLag();
+    resetEventLoopLoad();
+    resetEventLoopWakeupsPerSeconds();
+    onTcpInfoUpdated(0, 0, 0, 0, 0, 0);
+
+    return true;
+}
+
+bool Socket::send(const QByteArray& data)
+{
+    auto* worker = queueSend(data);
+    if(!worker)
+        return false;
+
+    QMetaObject::invokeMethod(worker, [worker, data]() { worker->onSendData(data); });
+    return true;
+}
+
+bool Socket::sendConflated(quint64 key, const QByteArray& data)
+{
+    auto* worker = queueSend(data);
+    if(!worker)
+        return false;
+
+    QMetaObject::invokeMethod(worker, [worker, key, data]() { worker->onSendConflated(key, data); });
+    return true;
+}
+
+SocketWorker* Socket::queueSend(const QByteArray& data)
+{
+    if(!_worker || !isRunning())
+        return nullptr;
+
+    // Counted now so queuedBytes is up to date before the worker process it
+    _worker->_queuedBytes += data.size();
+    return _worker;
+}
+
+quint64 Socket::queuedBytes() const { return _worker ? _worker->queuedBytes() : 0; }
+
+SocketOptions Socket::socketOptions() const
+{
+    SocketOptions options;
+    options.receiveBufferSize = receiveBufferSize();
+    options.sendBufferSize = sendBufferSize();
+    options.keepAliveIdle = keepAliveIdle();
+    options.keepAliveInterval = keepAliveInterval();
+    options.keepAliveCount = keepAliveCount();
+    options.userTimeout = userTimeout();
+    options.quickAck = quickAck();
+    options.notSentLowWatermark = notSentLowWatermark();
+    options.typeOfService = typeOfService();
+    options.priority = socketPriority();
+    return options;
+}
+
+void Socket::setSocketOptions(const SocketOptions& options)
+{
+    if(options == socketOptions())
+        return;
+
+    // Post the options once, not once per changed property
+    _settingSocketOptions = true;
+    setReceiveBufferSize(options.receiveBufferSize);
+    setSendBufferSize(options.sendBufferSize);
+    setKeepAliveIdle(options.keepAliveIdle);
+    setKeepAliveInterval(options.keepAliveInterval);
+    setKeepAliveCount(options.keepAliveCount);
+    setUserTimeout(options.userTimeout);
+    setQuickAck(options.quickAck);
+    setNotSentLowWatermark(options.notSentLowWatermark);
+    setTypeOfService(options.typeOfService);
+    setSocketPriority(options.priority);
+    _settingSocketOptions = false;
+    postSocketOptions();
+}
+
+void Socket::postSocketOptions()
+{
+    if(!_worker || _settingSocketOptions)
+        return;
+
+    // The worker skip options it already applied
+    auto* worker = _worker;
+    QMetaObject::invokeMethod(worker, [worker, options = socketOptions()]() { worker->setSocketOptions(options); });
+}
+
 bool Socket::restart()
 {
     if(isRunning())
@@ -283,6 +563,13 @@ void Socket::killWorker()
     }
 }
 
+void Socket::onRecordPathChanged()
+{
+    _recorder = recordPath().isEmpty() ? nullptr : TrafficRecorder::open(recordPath());
+    if(_worker)
+        _worker->setTrafficRecorder(_recorder);
+}
+
 void Socket::onStartSuccess(
     const QString& peerAddress, const quint16 peerPort, const QString& localAddress, const quint16 localPort)
 {
@@ -314,4 +601,54 @@ void Socket::onBytesSent(const uint64_t count)
     setTxBytesTotal(txBytesTotal() + count);
 }
 
+void Socket::onEventLoopStatsUpdated(quint64 lag, qreal load, quint64 wakeupsPerSeconds)
+{
+    setEventLoopLag(lag);
+    setEventLoopLoad(load);
+    setEventLoopWakeupsPerSeconds(wakeupsPerSeconds);
+}
+
+void Socket::onTcpInfoUpdated(quint32 rtt, quint32 rttVariance, quint32 congestionWindow, quint32 retransmits,
+    quint32 unackedSegments, quint32 sendQueueBytes)
+{
+    setTcpRtt(rtt);
+    setTcpRttVariance(rttVariance);
+    setTcpCongestionWindow(congestionWindow);
+    setTcpRetransmits(retransmits);
+    setTcpUnackedSegments(unackedSegments);
+    setTcpSendQueueBytes(sendQueueBytes);
+}
+
+void Socket::onIdleBuffersReleased(quint64 bytes) { setIdleReclaimedBytes(idleReclaimedBytes() + bytes); }
+
+void Socket::onOutboundDropped(quint64 count) { setOutboundDroppedCount(outboundDroppedCount() + count); }
+
+void Socket::onConflationUpdated(quint64 conflated, quint64 dropped)
+{
+    if(conflated)
+        setConflatedCount(conflatedCount() + conflated);
+    if(dropped)
+        setConflationDroppedCount(conflationDroppedCount() + dropped);
+}
+
+void Socket::onThrottleChanged(bool rx, bool tx)
+{
+    setRxThrottled(rx);
+    setTxThrottled(tx);
+}
+
+void Socket::onHeartbeatUpdated(quint64 rtt, quint64 jitter)
+{
+    setHeartbeatRtt(rtt);
+    setHeartbeatJitter(jitter);
+}
+
+void Socket::onReadStatsUpdated(quint64 budgetExceeded, quint64 dispatchTimeMax, quint64 requeueLatencyMax)
+{
+    if(budgetExceeded)
+        setReadBudgetExceededCount(readBudgetExceededCount() + budgetExceeded);
+    setReadDispatchTimeMax(dispatchTimeMax);
+    setReadRequeueLatencyMax(requeueLatencyMax);
+}
+
 SocketWorker* Socket::createWorker() { return new SocketWorker; }
@@ -0,0 +1,187 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/SocketOptions.hpp>
+
+// Qt Headers
+#include <QtCore/QFile>
+#include <QtNetwork/QAbstractSocket>
+
+// Stl Headers
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+// Linux Headers
+#    include <netinet/in.h>
+#    include <netinet/ip.h>
+#    include <netinet/tcp.h>
+#    include <sys/ioctl.h>
+#    include <sys/socket.h>
+#endif
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+#ifdef Q_OS_LINUX
+static bool setOption(int fd, int level, int name, int value)
+{
+    return ::setsockopt(fd, level, name, &value, sizeof(value)) == 0;
+}
+
+// Value of a net.ipv4 sysctl, used as default by sockets that don't set the option
+static int systemDefault(const char* path, int fallback)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+        return fallback;
+    bool ok = false;
+    const auto value = file.readAll().trimmed().toInt(&ok);
+    return ok ? value : fallback;
+}
+
+static void readOption(int fd, int level, int name, const char* key, QVariantMap& map)
+{
+    int value = 0;
+    socklen_t length = sizeof(value);
+    if(::getsockopt(fd, level, name, &value, &length) == 0)
+        map.insert(key, value);
+}
+#endif
+
+// ───── CLASS ─────
+
+bool SocketOptions::operator==(const SocketOptions& other) const
+{
+    return receiveBufferSize == other.receiveBufferSize && sendBufferSize == other.sendBufferSize &&
+           keepAliveIdle == other.keepAliveIdle && keepAliveInterval == other.keepAliveInterval &&
+           keepAliveCount == other.keepAliveCount && userTimeout == other.userTimeout && quickAck == other.quickAck &&
+           notSentLowWatermark == other.notSentLowWatermark && typeOfService == other.typeOfService &&
+           priority == other.priority;
+}
+
+bool SocketOptions::apply(QAbstractSocket* socket, const SocketOptions& previous) const
+{
+    if(!socket || socket->socketDescriptor() < 0)
+        return false;
+
+    if(receiveBufferSize > 0)
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, receiveBufferSize);
+    if(sendBufferSize > 0)
+        socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, sendBufferSize);
+    if(keepAliveIdle > 0)
+        socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+    else if(previous.keepAliveIdle > 0)
+        socket->setSocketOption(QAbstractSocket::KeepAliveOption, 0);
+    if(typeOfService > 0)
+        socket->setSocketOption(QAbstractSocket::TypeOfServiceOption, typeOfService);
+
+#ifdef Q_OS_LINUX
+    const auto fd = int(socket->socketDescriptor());
+    bool success = true;
+    // Keepalive options set back to 0 take the system wide value again
+    if(keepAliveIdle > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_KEEPIDLE, keepAliveIdle) && success;
+    else if(previous.keepAliveIdle > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_KEEPIDLE,
+                      systemDefault("/proc/sys/net/ipv4/tcp_keepalive_time", 7200)) &&
+                  success;
+    if(keepAliveInterval > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_KEEPINTVL, keepAliveInterval) && success;
+    else if(previous.keepAliveInterval > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_KEEPINTVL,
+                      systemDefault("/proc/sys/net/ipv4/tcp_keepalive_intvl", 75)) &&
+                  success;
+    if(keepAliveCount > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_KEEPCNT, keepAliveCount) && success;
+    else if(previous.keepAliveCount > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_KEEPCNT,
+                      systemDefault("/proc/sys/net/ipv4/tcp_keepalive_probes", 9)) &&
+                  success;
+#    ifdef TCP_USER_TIMEOUT
+    // 0 is the system default
+    if(userTimeout > 0 || previous.userTimeout > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, std::max(userTimeout, 0)) && success;
+#    endif
+    if(quickAck || previous.quickAck)
+        success = setOption(fd, IPPROTO_TCP, TCP_QUICKACK, quickAck ? 1 : 0) && success;
+#    ifdef TCP_NOTSENT_LOWAT
+    if(notSentLowWatermark > 0)
+        success = setOption(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, notSentLowWatermark) && success;
+#    endif
+    if(priority > 0)
+        success = setOption(fd, SOL_SOCKET, SO_PRIORITY, priority) && success;
+    return success;
+#else
+    return true;
+#endif
+}
+
+QVariantMap SocketOptions::effective(QAbstractSocket* socket)
+{
+    QVariantMap map;
+    if(!socket || socket->socketDescriptor() < 0)
+        return map;
+
+    map.insert("receiveBufferSize", socket->socketOption(QAbstractSocket::ReceiveBufferSizeSocketOption));
+    map.insert("sendBufferSize", socket->socketOption(QAbstractSocket::SendBufferSizeSocketOption));
+    map.insert("keepAlive", socket->socketOption(QAbstractSocket::KeepAliveOption).toBool());
+    map.insert("typeOfService", socket->socketOption(QAbstractSocket::TypeOfServiceOption));
+
+#ifdef Q_OS_LINUX
+    const auto fd = int(socket->socketDescriptor());
+    readOption(fd, IPPROTO_TCP, TCP_KEEPIDLE, "keepAliveIdle", map);
+    readOption(fd, IPPROTO_TCP, TCP_KEEPINTVL, "keepAliveInterval", map);
+    readOption(fd, IPPROTO_TCP, TCP_KEEPCNT, "keepAliveCount", map);
+#    ifdef TCP_USER_TIMEOUT
+    readOption(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, "userTimeout", map);
+#    endif
+    readOption(fd, IPPROTO_TCP, TCP_QUICKACK, "quickAck", map);
+#    ifdef TCP_NOTSENT_LOWAT
+    readOption(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, "notSentLowWatermark", map);
+#    endif
+    readOption(fd, SOL_SOCKET, SO_PRIORITY, "socketPriority", map);
+#endif
+    return map;
+}
+
+void SocketOptions::rearmQuickAck(qintptr socketDescriptor)
+{
+#ifdef Q_OS_LINUX
+    if(socketDescriptor >= 0)
+        setOption(int(socketDescriptor), IPPROTO_TCP, TCP_QUICKACK, 1);
+#else
+    Q_UNUSED(socketDescriptor);
+#endif
+}
+
+bool SocketOptions::setReceiveLowWatermark(qintptr socketDescriptor, int bytes)
+{
+#ifdef Q_OS_LINUX
+    return socketDescriptor >= 0 && setOption(int(socketDescriptor), SOL_SOCKET, SO_RCVLOWAT, std::max(bytes, 1));
+#else
+    Q_UNUSED(socketDescriptor);
+    Q_UNUSED(bytes);
+    return false;
+#endif
+}
+
+bool SocketOptions::isReceiveLowWatermarkSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+int SocketOptions::kernelBytesAvailable(qintptr socketDescriptor)
+{
+#ifdef Q_OS_LINUX
+    int bytes = 0;
+    return socketDescriptor >= 0 && ::ioctl(int(socketDescriptor), FIONREAD, &bytes) == 0 ? std::max(bytes, 0) : 0;
+#else
+    Q_UNUSED(socketDescriptor);
+    return 0;
+#endif
+}
@@ -0,0 +1,318 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/SocketPool.hpp>
+#include <Net/Tcp/Logger.hpp>
+
+// Qt Headers
+#include <QtCore/QTimer>
+
+// Stl Headers
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// clang-format off
+#ifdef NDEBUG
+# define LOG_DEV_DEBUG(str, ...) do {} while (0)
+#else
+# define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#endif
+
+#define LOG_INFO(str, ...)       NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_WARN(str, ...)       NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_ERR(str, ...)        NETTCP_LOG(Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+// clang-format on
+
+// ───── CLASS ─────
+
+SocketPool::SocketPool(QObject* parent) :
+    QOlm<Socket>(parent, {"peerAddress", "peerPort", "isConnected"}), _healthTimer(new QTimer(this))
+{
+    _healthTimer->setObjectName("healthTimer");
+    _healthTimer->setTimerType(Qt::CoarseTimer);
+    _healthTimer->setInterval(1000);
+    connect(_healthTimer, &QTimer::timeout, this, &SocketPool::checkHealth);
+
+    connect(this, &SocketPool::poolSizeChanged, this, &SocketPool::resize);
+    connect(this, &SocketPool::peerAddressChanged, this, &SocketPool::restart);
+    connect(this, &SocketPool::peerPortChanged, this, &SocketPool::restart);
+    connect(this, &SocketPool::useWorkerThreadChanged, this, &SocketPool::restart);
+    connect(this, &SocketPool::noDelayChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::watchdogPeriodChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::reconnectMultiplierChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::reconnectMaxDelayChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::reconnectJitterChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::connectTimeoutChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::connectAttemptDelayChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::outboundQueueSizeChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::outboundQueueMaxAgeChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::outboundQueueDropPolicyChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::heartbeatPeriodChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::heartbeatMaxMissedChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::rxRateLimitChanged, this, &SocketPool::configureMembers);
+    connect(this, &SocketPool::txRateLimitChanged, this, &SocketPool::configureMembers);
+}
+
+SocketPool::~SocketPool() { stop(); }
+
+bool SocketPool::start()
+{
+    if(isRunning())
+    {
+        LOG_WARN("Can't start socket pool that is already running");
+        return false;
+    }
+
+    LOG_INFO("Start {} sockets to {}:{}", poolSize(), qPrintable(peerAddress()), int(peerPort()));
+    setRunning(true);
+    resize();
+    _healthTimer->start();
+    return true;
+}
+
+bool SocketPool::start(const QString& host, const quint16 port)
+{
+    // Avoid restart on each property change
+    stop();
+    setPeerAddress(host);
+    setPeerPort(port);
+    return start();
+}
+
+bool SocketPool::stop()
+{
+    if(!isRunning())
+        return false;
+
+    _healthTimer->stop();
+    resetRunning();
+    // Members are children of the pool, remove delete them
+    clear();
+    _stoppedSince.clear();
+    resetConnectedCount();
+    resetRxBytesPerSeconds();
+    resetTxBytesPerSeconds();
+    resetQueuedBytes();
+    return true;
+}
+
+bool SocketPool::restart()
+{
+    if(!isRunning())
+        return false;
+
+    LOG_INFO("Restart");
+    stop();
+    return start();
+}
+
+bool SocketPool::send(const QByteArray& data)
+{
+    auto* socket = Strategy(strategy()) == Strategy::KeyAffinity ? pickRoundRobin() : pick();
+    if(!socket)
+    {
+        setDroppedCount(droppedCount() + 1);
+        return false;
+    }
+    return socket->send(data);
+}
+
+bool SocketPool::send(const QByteArray& data, quint64 key)
+{
+    auto* socket = pick(key);
+    if(!socket)
+    {
+        setDroppedCount(droppedCount() + 1);
+        return false;
+    }
+    return socket->send(data);
+}
+
+Socket* SocketPool::pick(quint64 key)
+{
+    switch(Strategy(strategy()))
+    {
+    case Strategy::LeastQueued: return pickLeastQueued();
+    case Strategy::KeyAffinity: return pickKeyAffinity(key);
+    case Strategy::RoundRobin:
+    default: return pickRoundRobin();
+    }
+}
+
+Socket* SocketPool::pickRoundRobin()
+{
+    const auto members = count();
+    for(int i = 0; i < members; ++i)
+    {
+        auto* socket = at((_nextMember + i) % members);
+        if(socket->isConnected())
+        {
+            _nextMember = (_nextMember + i + 1) % members;
+            return socket;
+        }
+    }
+    return nullptr;
+}
+
+Socket* SocketPool::pickLeastQueued()
+{
+    Socket* best = nullptr;
+    quint64 bestQueued = std::numeric_limits<quint64>::max();
+    for(auto* socket: *this)
+    {
+        if(!socket->isConnected())
+            continue;
+
+        const auto queued = socket->queuedBytes();
+        if(queued < bestQueued)
+        {
+            best = socket;
+            bestQueued = queued;
+        }
+    }
+    return best;
+}
+
+Socket* SocketPool::pickKeyAffinity(quint64 key)
+{
+    // Members keep their index when replaced, so a key move only while its member is down
+    const auto members = count();
+    if(!members)
+        return nullptr;
+
+    const auto first = int(key % quint64(members));
+    for(int i = 0; i < members; ++i)
+    {
+        auto* socket = at((first + i) % members);
+        if(socket->isConnected())
+            return socket;
+    }
+    return nullptr;
+}
+
+Socket* SocketPool::newSocket(QObject* parent) { return new Socket(parent); }
+
+Socket* SocketPool::addMember()
+{
+    auto* socket = newSocket(this);
+    socket->setUseWorkerThread(useWorkerThread());
+    configureMember(socket);
+    socket->start(peerAddress(), peerPort());
+    return socket;
+}
+
+void SocketPool::configureMember(Socket* socket) const
+{
+    socket->setNoDelay(noDelay());
+    socket->setWatchdogPeriod(watchdogPeriod());
+    socket->setReconnectMultiplier(reconnectMultiplier());
+    socket->setReconnectMaxDelay(reconnectMaxDelay());
+    socket->setReconnectJitter(reconnectJitter());
+    socket->setConnectTimeout(connectTimeout());
+    socket->setConnectAttemptDelay(connectAttemptDelay());
+    socket->setOutboundQueueSize(outboundQueueSize());
+    socket->setOutboundQueueMaxAge(outboundQueueMaxAge());
+    socket->setOutboundQueueDropPolicy(outboundQueueDropPolicy());
+    socket->setHeartbeatPeriod(heartbeatPeriod());
+    socket->setHeartbeatMaxMissed(heartbeatMaxMissed());
+    socket->setRxRateLimit(rxRateLimit());
+    socket->setTxRateLimit(txRateLimit());
+}
+
+void SocketPool::configureMembers()
+{
+    for(auto* socket: *this) configureMember(socket);
+}
+
+void SocketPool::replaceMember(Socket* socket)
+{
+    const auto index = indexOf(socket);
+    if(index < 0)
+        return;
+
+    _rxBytesTotalRemoved += socket->rxBytesTotal();
+    _txBytesTotalRemoved += socket->txBytesTotal();
+    _stoppedSince.remove(socket);
+    disconnect(socket, nullptr, this, nullptr);
+
+    // Keep the index of the member for KeyAffinity
+    remove(socket);
+    insert(index, addMember());
+
+    setReplacedCount(replacedCount() + 1);
+    Q_EMIT memberReplaced(index);
+}
+
+void SocketPool::resize()
+{
+    if(!isRunning())
+        return;
+
+    const auto target = std::max(poolSize(), 0);
+    while(count() < target) append(addMember());
+    while(count() > target)
+    {
+        auto* socket = at(count() - 1);
+        _rxBytesTotalRemoved += socket->rxBytesTotal();
+        _txBytesTotalRemoved += socket->txBytesTotal();
+        _stoppedSince.remove(socket);
+        disconnect(socket, nullptr, this, nullptr);
+        remove(socket);
+    }
+}
+
+void SocketPool::checkHealth()
+{
+    const auto timeout = replaceTimeout();
+
+    int connected = 0;
+    quint64 rxPerSeconds = 0;
+    quint64 txPerSeconds = 0;
+    quint64 rxTotal = _rxBytesTotalRemoved;
+    quint64 txTotal = _txBytesTotalRemoved;
+    quint64 queued = 0;
+    std::vector<Socket*> failed;
+
+    for(auto* socket: *this)
+    {
+        rxPerSeconds += socket->rxBytesPerSeconds();
+        txPerSeconds += socket->txBytesPerSeconds();
+        rxTotal += socket->rxBytesTotal();
+        txTotal += socket->txBytesTotal();
+        queued += socket->queuedBytes();
+
+        if(socket->isConnected())
+            ++connected;
+
+        // A running member retry on its own, replacing it would reset its reconnect backoff
+        if(socket->isRunning())
+        {
+            _stoppedSince.remove(socket);
+            continue;
+        }
+
+        auto& since = _stoppedSince[socket];
+        if(!since.isValid())
+            since.start();
+        else if(timeout && quint64(since.elapsed()) >= timeout)
+            failed.push_back(socket);
+    }
+
+    setConnectedCount(connected);
+    setRxBytesPerSeconds(rxPerSeconds);
+    setTxBytesPerSeconds(txPerSeconds);
+    setRxBytesTotal(rxTotal);
+    setTxBytesTotal(txTotal);
+    setQueuedBytes(queued);
+
+    for(auto* socket: failed)
+    {
+        LOG_ERR("Member not running for more than {} ms, replace it", timeout);
+        replaceMember(socket);
+    }
+}
@@ -2,13 +2,25 @@
 
 // Library Headers
 #include <Net/Tcp/SocketWorker.hpp>
+#include <Net/Tcp/HostCache.hpp>
+#include <Net/Tcp/EventLoopMonitor.hpp>
+#include <Net/Tcp/TcpInfo.hpp>
+#include <Net/Tcp/TrafficRecorder.hpp>
 #include <Net/Tcp/Logger.hpp>
+#include <Net/Tcp/Trace.hpp>
 
 // Qt Headers
 #include <QtCore/QTimer>
+#include <QtCore/QtEndian>
 #include <QtNetwork/QHostAddress>
+#include <QtNetwork/QHostInfo>
 #include <QtNetwork/QTcpSocket>
 
+// Stl Headers
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 // ───── DECLARATION ─────
 
 using namespace net::tcp;
@@ -17,70 +29,128 @@ using namespace net::tcp;
 #ifdef NDEBUG
 # define LOG_DEV_DEBUG(str, ...) do {} while (0)
 #else
-# define LOG_DEV_DEBUG(str, ...) Logger::SOCKET_WORKER->debug( "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_INFO(str, ...)  do {} while (0)
 #else
-# define LOG_DEV_INFO(str, ...)  Logger::SOCKET_WORKER->info(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_INFO(str, ...)  NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_WARN(str, ...)  do {} while (0)
 #else
-# define LOG_DEV_WARN(str, ...)  Logger::SOCKET_WORKER->warn(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_WARN(str, ...)  NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_ERR(str, ...)   do {} while (0)
 #else
-# define LOG_DEV_ERR(str, ...)   Logger::SOCKET_WORKER->error( "[{}] " str, (void*)(this), ## __VA_ARGS__)
+# define LOG_DEV_ERR(str, ...)   NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 #endif
 
-#define LOG_DEBUG(str, ...)      Logger::SOCKET_WORKER->debug( "[{}] " str, (void*)(this), ## __VA_ARGS__)
-#define LOG_INFO(str, ...)       Logger::SOCKET_WORKER->info(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
-#define LOG_WARN(str, ...)       Logger::SOCKET_WORKER->warn(  "[{}] " str, (void*)(this), ## __VA_ARGS__)
-#define LOG_ERR(str, ...)        Logger::SOCKET_WORKER->error( "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_DEBUG(str, ...)      NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::debug, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_INFO(str, ...)       NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_WARN(str, ...)       NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::warn, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_ERR(str, ...)        NETTCP_LOG(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_DEBUG_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::debug, this, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_INFO_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::info, this, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_ERR_THROTTLED(str, ...) NETTCP_LOG_THROTTLED(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::err, this, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_DEBUG_THROTTLED_BY(variant, str, ...) NETTCP_LOG_THROTTLED_BY(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::debug, this, variant, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_ERR_THROTTLED_BY(variant, str, ...) NETTCP_LOG_THROTTLED_BY(Logger::SOCKET_WORKER, NETTCP_SOCKET_WORKER_LOG_LEVEL, spdlog::level::err, this, variant, "[{}] " str, (void*)(this), ## __VA_ARGS__)
 // clang-format on
 
+// readMaxDelay is in ms, the default 100 ms wheel is too coarse for it
+static const int readCoalescingResolution = 1;
+
+// Send time of pings in µs, only compared with itself
+static quint64 heartbeatClock()
+{
+    using namespace std::chrono;
+    return quint64(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
 // ───── CLASS ─────
 
-SocketWorker::SocketWorker(QObject* parent) : QObject(parent) {}
+SocketWorker::SocketWorker(QObject* parent) : QObject(parent)
+{
+    _outboundClock.start();
+    _readClock.start();
+}
 
-SocketWorker::~SocketWorker() = default;
+SocketWorker::~SocketWorker()
+{
+    releaseConnectSlot();
+    // Storage of the worker can be reused by the next connection
+    Logger::forgetThrottled(this);
+}
 
 void SocketWorker::onStart()
 {
-    if(_socketDescriptor)
-        LOG_DEV_INFO("Start worker {}", std::uintptr_t(_socketDescriptor));
-    else
-        LOG_DEV_INFO("Start worker {}:{}", qPrintable(_address), int(_port));
-
-    Q_ASSERT(!_socket);
-    _socket = new QTcpSocket(this);
-    _socket->setObjectName("socket");
-    if(_socketDescriptor)
+    // Wait for a slot when concurrent connection attempts are limited
+    if(!_socketDescriptor && !_connectSlotGranted && ReconnectScheduler::instance().isEnabled())
     {
-        const auto result = _socket->setSocketDescriptor(_socketDescriptor);
-        if(!result)
+        if(!_connectTicket)
         {
-            _socket->deleteLater();
-            _socket = nullptr;
-            LOG_ERR("Fail to set socket descriptor. Can't start the socket.");
-            Q_EMIT startFailed();
-            return;
+            _connectTicket = ReconnectScheduler::instance().acquire(this,
+                [this](ReconnectScheduler::Ticket ticket)
+                {
+                    // Released since
+                    if(ticket != _connectTicket)
+                        return;
+                    _connectSlotGranted = true;
+                    onStart();
+                });
+            LOG_DEV_DEBUG("Wait for a connect slot");
         }
+        return;
     }
-    else
+
+    NETTCP_TRACE_INSTANT("socket", "start", this);
+
+    if(!_socketDescriptor)
+    {
+        LOG_DEV_INFO("Start worker {}:{}", qPrintable(_address), int(_port));
+        NETTCP_TRACE_INSTANT("socket", "connect", this);
+        _isRunning = true;
+        applyMonitorEventLoop();
+        connectToHost();
+        return;
+    }
+
+    LOG_DEV_INFO("Start worker {}", std::uintptr_t(_socketDescriptor));
+
+    Q_ASSERT(!_socket);
+    _socket = new QTcpSocket(this);
+    if(!_slimMode)
+        _socket->setObjectName("socket");
+    const auto result = _socket->setSocketDescriptor(_socketDescriptor);
+    if(!result)
     {
-        _socket->connectToHost(_address, _port);
+        _socket->deleteLater();
+        _socket = nullptr;
+        LOG_ERR("Fail to set socket descriptor. Can't start the socket.");
+        Q_EMIT startFailed();
+        return;
     }
 
     _isRunning = true;
+    connectSocketSignals();
+
+    if(_socket->state() == QAbstractSocket::ConnectedState)
+        onConnected();
+
+    applyNoDelayOption();
+    applySocketOptions();
+    applyMonitorEventLoop();
+}
 
+void SocketWorker::connectSocketSignals()
+{
+    Q_ASSERT(_socket);
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-    connect(_socket QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this,
+    connect(_socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this,
         &SocketWorker::onSocketError);
 #else
     connect(_socket, &QAbstractSocket::errorOccurred, this, &SocketWorker::onSocketError);
@@ -88,12 +158,27 @@ void SocketWorker::onStart()
     connect(_socket, &QTcpSocket::stateChanged, this, &SocketWorker::onSocketStateChanged);
     connect(_socket, &QTcpSocket::connected, this, &SocketWorker::onConnected);
     connect(_socket, &QTcpSocket::disconnected, this, &SocketWorker::onDisconnected);
-    connect(_socket, &QTcpSocket::readyRead, this, &SocketWorker::onDataAvailable);
+    connect(_socket, &QTcpSocket::readyRead, this, &SocketWorker::onReadyRead);
+    connect(_socket, &QTcpSocket::bytesWritten, this, &SocketWorker::onBytesWritten);
+}
 
-    if(_socket->state() == QAbstractSocket::ConnectedState)
-        onConnected();
+void SocketWorker::setSocketOptions(const SocketOptions& options)
+{
+    if(options == _socketOptions)
+        return;
+    const auto previous = _socketOptions;
+    _socketOptions = options;
+    applySocketOptions(previous);
+}
 
-    applyNoDelayOption();
+void SocketWorker::applySocketOptions(const SocketOptions& previous)
+{
+    if(!_socket)
+        return;
+
+    if(!_socketOptions.apply(_socket, previous))
+        LOG_WARN("Some socket options are refused by the system");
+    Q_EMIT socketOptionsApplied(SocketOptions::effective(_socket));
 }
 
 void SocketWorker::onStop()
@@ -101,12 +186,20 @@ void SocketWorker::onStop()
     LOG_INFO("Stop Worker");
     _isRunning = false;
     stopWatchdog();
+    stopIdleTimer();
     stopBytesCounter();
+    stopTcpInfoSampling();
+    applyMonitorEventLoop();
     closeSocket();
+    clearOutboundQueue();
+    // A recycled worker serve its next connection with fresh throttle windows
+    Logger::forgetThrottled(this);
 }
 
 void SocketWorker::closeSocket()
 {
+    releaseConnectSlot();
+    abortConnectAttempts();
     if(!_socket)
         return;
 
@@ -115,6 +208,8 @@ void SocketWorker::closeSocket()
         return;
     _pendingClosing = true;
 
+    NETTCP_TRACE_INSTANT("socket", "close", this);
+
     if(_socketDescriptor)
         LOG_DEV_INFO("Close socket worker {}", _socketDescriptor);
     else
@@ -123,6 +218,14 @@ void SocketWorker::closeSocket()
     Q_ASSERT(_socket);
     disconnect(this, nullptr, _socket, nullptr);
     disconnect(_socket, nullptr, this, nullptr);
+    // Bytes still buffered by the socket are lost, unless the outbound queue keep them
+    _queuedBytes -= _socket->bytesToWrite();
+    requeueInFlight();
+    clearConflationQueue();
+    clearRateLimitState();
+    _readRequeued = false;
+    // Bytes of the lost connection, the storage is kept for the next one
+    _receiveBuffer.clear();
     onDisconnected();
     _socket->close();
 
@@ -135,6 +238,20 @@ void SocketWorker::closeSocket()
 }
 
 std::size_t SocketWorker::write(const std::uint8_t* buffer, const std::size_t length)
+{
+    const auto written = writeBytes(reinterpret_cast<const char*>(buffer), length);
+    if(written)
+        onActivity();
+    return written;
+}
+
+std::size_t SocketWorker::writeControl(const char* buffer, std::size_t length)
+{
+    // Paced like other bytes, so they are written after the whole frame before them
+    return writeBytes(buffer, length);
+}
+
+std::size_t SocketWorker::writeBytes(const char* buffer, std::size_t length)
 {
     if(!_socket)
     {
@@ -147,27 +264,43 @@ std::size_t SocketWorker::write(const std::uint8_t* buffer, const std::size_t le
         return false;
     }
 
-    std::size_t bytesWritten = 0;
-    std::size_t bytesLeft = length;
+    // Bytes above the tx rate limit are given to the socket later by the pacing timer
+    const auto direct = txAllowance(length);
+    if(direct && !writeToSocket(buffer, direct))
+        return 0;
+    if(direct < length)
+    {
+        _pacedData.append(buffer + direct, int(length - direct));
+        startPacingTimer();
+        updateThrottle();
+    }
 
+    _txBytesCounter += length;
+    _queuedBytes += qint64(length);
+    if(_outboundQueueSize && !_flushingOutbound)
+        _inFlight.push_back({QByteArray(), qint64(length), 0});
+    if(_recorder)
+        _recorder->record(_recordConnection, TrafficRecorder::Direction::Tx, buffer, length);
+    return length;
+}
+
+bool SocketWorker::writeToSocket(const char* buffer, std::size_t length)
+{
+    std::size_t bytesWritten = 0;
     while(bytesWritten != length)
     {
-        const auto currentBytesWritten =
-            _socket->write(reinterpret_cast<const char*>(buffer) + bytesWritten, bytesLeft - bytesWritten);
+        const auto currentBytesWritten = _socket->write(buffer + bytesWritten, qint64(length - bytesWritten));
 
         if(currentBytesWritten < 0)
         {
             LOG_ERR("Fail to write to socket");
             closeAndRestart();
-            return 0;
+            return false;
         }
 
         bytesWritten += std::size_t(currentBytesWritten);
-        bytesLeft -= std::size_t(currentBytesWritten);
     }
-
-    _txBytesCounter += length;
-    return bytesWritten;
+    return true;
 }
 
 std::size_t SocketWorker::write(const char* buffer, const std::size_t length)
@@ -175,175 +308,1227 @@ std::size_t SocketWorker::write(const char* buffer, const std::size_t length)
     return write(reinterpret_cast<const std::uint8_t*>(buffer), length);
 }
 
-void SocketWorker::onSocketError(const QAbstractSocket::SocketError e)
+quint64 SocketWorker::queuedBytes() const { return quint64(std::max<qint64>(_queuedBytes.load(), 0)); }
+
+std::size_t SocketWorker::bytesToWrite() const
 {
-    // todo : use our own error type
-    if(_socket)
+    return _socket ? std::size_t(_socket->bytesToWrite()) + std::size_t(_pacedData.size()) : 0;
+}
+
+void SocketWorker::onWriteProgress(qint64) {}
+
+bool SocketWorker::writeMessage(const QByteArray& message)
+{
+    return write(message.constData(), std::size_t(message.size())) == std::size_t(message.size());
+}
+
+void SocketWorker::onSendData(const QByteArray& data)
+{
+    // Counted by Socket::send, write or the outbound queue count it again
+    _queuedBytes -= data.size();
+
+    if(_outboundQueueSize)
     {
-        LOG_ERR("Socket Error ({}) : {}", int(e), qPrintable(_socket->errorString()));
+        // Keep the order of data queued while disconnected
+        if(!isConnected() || !_outboundQueue.empty())
+        {
+            enqueueOutbound(data);
+            return;
+        }
+
+        // Tracked before write, a failed write send it again on next connection
+        _inFlight.push_back({data, qint64(data.size()), 0});
+        _flushingOutbound = true;
+        write(data.constData(), std::size_t(data.size()));
+        _flushingOutbound = false;
+        return;
     }
-    else
+
+    if(!isConnected())
     {
-        LOG_ERR("Socket Error ({})", int(e));
+        LOG_DEV_DEBUG("Drop {} bytes sent while not connected", data.size());
+        return;
     }
-    Q_EMIT socketError(int(e), _socket ? _socket->errorString() : QStringLiteral("Invalid Socket"));
+    writeMessage(data);
+}
 
-    if(e == QAbstractSocket::SocketError::ConnectionRefusedError)
+void SocketWorker::onBytesWritten(qint64 bytes)
+{
+    NETTCP_TRACE_INSTANT("socket", "flush", this, std::uint64_t(bytes));
+    _queuedBytes -= bytes;
+
+    if(!_conflationOrder.empty())
+        flushConflationQueue();
+    onWriteProgress(bytes);
+
+    if(_inFlight.empty())
+        return;
+
+    // Forget messages once fully written to the kernel
+    _inFlightWritten += bytes;
+    while(!_inFlight.empty() && _inFlightWritten >= _inFlight.front().size)
     {
-        closeAndRestart();
+        _inFlightWritten -= _inFlight.front().size;
+        _inFlight.pop_front();
     }
+    if(_inFlight.empty())
+        _inFlightWritten = 0;
 }
 
-void SocketWorker::onSocketStateChanged(QAbstractSocket::SocketState socketState)
+void SocketWorker::setOutboundQueueSize(quint64 value)
 {
-    LOG_INFO("New Socket state : {}", (int)socketState);
-    if(socketState == QAbstractSocket::UnconnectedState)
+    _outboundQueueSize = value;
+    if(!_outboundQueueSize)
+        clearOutboundQueue();
+    else
+        trimOutboundQueue();
+}
+
+void SocketWorker::setOutboundQueueMaxAge(quint64 value)
+{
+    _outboundQueueMaxAge = value;
+    dropExpiredOutbound();
+}
+
+void SocketWorker::setOutboundQueueDropPolicy(int value) { _outboundQueueDropPolicy = value; }
+
+void SocketWorker::enqueueOutbound(const QByteArray& data)
+{
+    dropExpiredOutbound();
+    _outboundQueue.push_back({data, qint64(data.size()), _outboundClock.elapsed()});
+    _outboundQueueBytes += quint64(data.size());
+    _queuedBytes += data.size();
+    trimOutboundQueue();
+}
+
+void SocketWorker::trimOutboundQueue()
+{
+    quint64 dropped = 0;
+    while(_outboundQueueBytes > _outboundQueueSize && !_outboundQueue.empty())
     {
-        onDisconnected();
+        const auto dropNewest = _outboundQueueDropPolicy == 1;
+        const auto size = dropNewest ? _outboundQueue.back().size : _outboundQueue.front().size;
+        if(dropNewest)
+            _outboundQueue.pop_back();
+        else
+            _outboundQueue.pop_front();
+        _outboundQueueBytes -= quint64(size);
+        _queuedBytes -= size;
+        ++dropped;
+    }
+
+    if(dropped)
+    {
+        LOG_DEBUG_THROTTLED("Outbound queue full, {} messages dropped", dropped);
+        Q_EMIT outboundDropped(dropped);
     }
 }
 
-void SocketWorker::onConnected()
+void SocketWorker::dropExpiredOutbound()
 {
-    // Avoid nested call with connections
-    if(_isConnected)
+    if(!_outboundQueueMaxAge)
         return;
-    _isConnected = true;
 
-    Q_ASSERT(_socket);
-    stopWatchdog();
-    LOG_INFO("Socket is connected to {}:{}", qPrintable(_socket->peerAddress().toString()), _socket->peerPort());
-    Q_EMIT startSuccess(_socket ? _socket->peerAddress().toString() : "", _socket ? _socket->peerPort() : 0,
-        _socket ? _socket->localAddress().toString() : "", _socket ? _socket->localPort() : 0);
-    Q_EMIT connectionChanged(true);
+    const auto now = _outboundClock.elapsed();
+    quint64 dropped = 0;
+    while(!_outboundQueue.empty() && quint64(now - _outboundQueue.front().time) >= _outboundQueueMaxAge)
+    {
+        _outboundQueueBytes -= quint64(_outboundQueue.front().size);
+        _queuedBytes -= _outboundQueue.front().size;
+        _outboundQueue.pop_front();
+        ++dropped;
+    }
 
-    startBytesCounter();
+    if(dropped)
+    {
+        LOG_DEBUG_THROTTLED("{} outbound messages expired", dropped);
+        Q_EMIT outboundDropped(dropped);
+    }
 }
 
-void SocketWorker::onDisconnected()
+void SocketWorker::setConflationThreshold(quint64 value)
 {
-    // Avoid nested call with connections
-    if(!_isConnected)
+    _conflationThreshold = value;
+    if(!_conflationOrder.empty())
+        flushConflationQueue();
+}
+
+void SocketWorker::setConflationMaxKeys(int value) { _conflationMaxKeys = std::max(value, 0); }
+
+void SocketWorker::onSendConflated(quint64 key, const QByteArray& data)
+{
+    // Counted by Socket::sendConflated, write or the conflation queue count it again
+    _queuedBytes -= data.size();
+
+    if(!isConnected())
+    {
+        ++_conflationDroppedCounter;
         return;
-    _isConnected = false;
+    }
 
-    if(_socket)
+    const auto it = _conflationQueue.find(key);
+    if(it != _conflationQueue.end())
     {
-        LOG_INFO("Socket disconnected from {}:{}", qPrintable(_socket->peerAddress().toString()), _socket->peerPort());
+        // Keep the place of the key in the send order
+        _queuedBytes += data.size() - it->second.size();
+        it->second = data;
+        ++_conflatedCounter;
+        return;
     }
-    Q_EMIT connectionChanged(false);
-    if(!_socketDescriptor)
-        closeAndRestart();
 
-    stopBytesCounter();
+    if(_conflationOrder.empty() && !isCongested())
+    {
+        writeMessage(data);
+        return;
+    }
+
+    if(_conflationMaxKeys && int(_conflationOrder.size()) >= _conflationMaxKeys)
+    {
+        ++_conflationDroppedCounter;
+        LOG_DEBUG_THROTTLED("Conflation queue is full with {} keys, drop data", _conflationOrder.size());
+        return;
+    }
+
+    _queuedBytes += data.size();
+    _conflationOrder.push_back(key);
+    _conflationQueue.emplace(key, data);
 }
 
-bool SocketWorker::isConnected() const { return _socket && _socket->state() == QAbstractSocket::ConnectedState; }
+bool SocketWorker::isCongested() const { return quint64(bytesToWrite()) > _conflationThreshold; }
 
-void SocketWorker::onDataAvailable() { LOG_DEV_WARN("You need to override onDataAvailable"); }
+void SocketWorker::flushConflationQueue()
+{
+    // write can close the socket
+    while(!_conflationOrder.empty() && isConnected() && !isCongested())
+    {
+        const auto it = _conflationQueue.find(_conflationOrder.front());
+        _conflationOrder.pop_front();
+        Q_ASSERT(it != _conflationQueue.end());
+
+        const auto data = std::move(it->second);
+        _conflationQueue.erase(it);
+        _queuedBytes -= data.size();
+        writeMessage(data);
+    }
+}
 
-std::size_t SocketWorker::bytesAvailable() const { return _socket ? _socket->bytesAvailable() : 0; }
+void SocketWorker::clearConflationQueue()
+{
+    if(_conflationOrder.empty())
+        return;
 
-std::size_t SocketWorker::read(std::uint8_t* data, std::size_t maxLen)
+    for(const auto& held: _conflationQueue) _queuedBytes -= held.second.size();
+    _conflationDroppedCounter += _conflationOrder.size();
+    _conflationOrder.clear();
+    _conflationQueue.clear();
+}
+
+void SocketWorker::reportConflation()
 {
-    return read(reinterpret_cast<char*>(data), maxLen);
+    if(!_conflatedCounter && !_conflationDroppedCounter)
+        return;
+
+    Q_EMIT conflationUpdated(_conflatedCounter, _conflationDroppedCounter);
+    _conflatedCounter = 0;
+    _conflationDroppedCounter = 0;
 }
 
-std::size_t SocketWorker::read(char* data, std::size_t maxLen)
+void SocketWorker::setRxRateLimit(quint64 value)
 {
-    if(!_socket)
-        LOG_DEV_WARN("Don't call read when socket is null. Check with isConnected().");
+    _rxBucket.setRate(value);
+    applyReadBufferSize();
+    // Data held by a previous limit is read now
+    if(!isRxLimited() && _rxPaused)
+        resumeRx();
+}
 
-    const auto byteRead = _socket ? _socket->read(data, maxLen) : 0;
-    _rxBytesCounter += byteRead;
-    return byteRead;
+void SocketWorker::setTxRateLimit(quint64 value)
+{
+    _txBucket.setRate(value);
+    if(!_pacedData.isEmpty())
+        flushPacedData();
 }
 
-void SocketWorker::onWatchdogPeriodChanged(quint64 period)
+qint64 SocketWorker::rxTokens()
 {
-    _watchdogPeriod = period;
-    // Restart the watchdog with new period
-    if(_watchdog && _watchdog->isActive())
-        closeAndRestart();
+    const auto tokens = qint64(_rxBucket.available());
+    return _serverRxBucket ? std::min<qint64>(tokens, _serverRxBucket->available()) : tokens;
 }
 
-void SocketWorker::onWatchdogTimeout()
+qint64 SocketWorker::txTokens()
 {
-    // Try to restart the server, or start watchdog
-    onStart();
+    const auto tokens = qint64(_txBucket.available());
+    return _serverTxBucket ? std::min<qint64>(tokens, _serverTxBucket->available()) : tokens;
 }
 
-void SocketWorker::closeAndRestart()
+bool SocketWorker::isRxLimited() const
 {
-    if(!_isRunning)
+    return _rxBucket.isLimited() || (_serverRxBucket && _serverRxBucket->isLimited());
+}
+
+bool SocketWorker::isTxLimited() const
+{
+    return _txBucket.isLimited() || (_serverTxBucket && _serverTxBucket->isLimited());
+}
+
+void SocketWorker::consumeRx(std::size_t bytes)
+{
+    if(_rxBucket.isLimited())
+        _rxBucket.consume(bytes);
+    if(_serverRxBucket && _serverRxBucket->isLimited())
+        _serverRxBucket->consume(bytes);
+}
+
+void SocketWorker::consumeTx(std::size_t bytes)
+{
+    if(_txBucket.isLimited())
+        _txBucket.consume(bytes);
+    if(_serverTxBucket && _serverTxBucket->isLimited())
+        _serverTxBucket->consume(bytes);
+}
+
+std::size_t SocketWorker::txAllowance(std::size_t length)
+{
+    if(!isTxLimited())
+        return length;
+    // Keep the order of bytes already paced
+    if(!_pacedData.isEmpty())
+        return 0;
+
+    const auto allowed = std::min(std::size_t(std::max<qint64>(txTokens(), 0)), length);
+    consumeTx(allowed);
+    return allowed;
+}
+
+void SocketWorker::startPacingTimer()
+{
+    if(_pacingTimerId && TimerWheel::instance()->isActive(_pacingTimerId))
         return;
 
-    LOG_INFO("Close and try to restart socket in {} ms", _watchdogPeriod);
+    // Wait for enough tokens to write a part of the paced bytes, the wheel round the delay to its tick
+    const auto bytes = std::uint64_t(_pacedData.size());
+    auto delay = _txBucket.delayFor(bytes);
+    if(_serverTxBucket)
+        delay = std::max(delay, _serverTxBucket->delayFor(bytes));
+    _pacingTimerId =
+        TimerWheel::instance()->start(int(std::max<std::uint64_t>(delay, 1)), this, [this]() { flushPacedData(); });
+}
 
-    // Don't restart again
-    if(_watchdog && (_watchdog->remainingTime() > 0) && _watchdog->remainingTime() <= int(_watchdogPeriod))
+void SocketWorker::flushPacedData()
+{
+    if(_pacingTimerId)
     {
-        LOG_INFO("Socket Restart timer is already running. Remaining time "
-                 "before restart : {} ms",
-            _watchdog->remainingTime());
+        TimerWheel::instance()->stop(_pacingTimerId);
+        _pacingTimerId = 0;
+    }
+    if(!isConnected())
         return;
+
+    const auto tokens = isTxLimited() ? std::max<qint64>(txTokens(), 0) : qint64(_pacedData.size());
+    const auto bytes = int(std::min<qint64>(tokens, _pacedData.size()));
+    if(bytes)
+    {
+        if(isTxLimited())
+            consumeTx(std::size_t(bytes));
+        // A failed write close the socket and drop the paced bytes
+        if(!writeToSocket(_pacedData.constData(), std::size_t(bytes)))
+            return;
+        _pacedData.remove(0, bytes);
     }
 
-    closeSocket();
+    if(!_pacedData.isEmpty())
+        startPacingTimer();
+    updateThrottle();
+}
 
-    // Can't restart a socket descriptor based socket
-    // Just need to wait for the parent to kill it
-    if(_socketDescriptor)
+void SocketWorker::pauseRx()
+{
+    _rxPaused = true;
+    auto delay = _rxBucket.delayFor(1);
+    if(_serverRxBucket)
+        delay = std::max(delay, _serverRxBucket->delayFor(1));
+    _rxResumeTimerId =
+        TimerWheel::instance()->start(int(std::max<std::uint64_t>(delay, 1)), this, [this]() { resumeRx(); });
+    updateThrottle();
+}
+
+void SocketWorker::resumeRx()
+{
+    if(_rxResumeTimerId)
     {
-        LOG_DEV_DEBUG("Don't start watchdog for worker, because it have been "
-                      "created with a socketDescriptor. Please kill this socket worker from owner");
-        return;
+        TimerWheel::instance()->stop(_rxResumeTimerId);
+        _rxResumeTimerId = 0;
     }
+    _rxPaused = false;
+    updateThrottle();
+    // readyRead isn't emitted again for bytes already buffered
+    if(bytesAvailable())
+        onReadyRead();
+}
 
-    if(!_watchdog)
-    {
-        _watchdog = new QTimer(this);
-        _watchdog->setObjectName("watchdog");
-        LOG_DEV_DEBUG("Allocate watchdog {}", static_cast<void*>(_watchdog));
+void SocketWorker::applyReadBufferSize() const
+{
+    if(!_socket)
+        return;
 
-        connect(_watchdog, &QTimer::timeout, this, &SocketWorker::onWatchdogTimeout);
-        _watchdog->setTimerType(Qt::VeryCoarseTimer);
-        _watchdog->setSingleShot(true);
-    }
-    _watchdog->start(_watchdogPeriod);
-    LOG_INFO("Start Watchdog to attempt reconnection in {} ms", int(_watchdogPeriod));
+    std::uint64_t cap = 0;
+    if(_rxBucket.isLimited())
+        cap = _rxBucket.burst();
+    if(_serverRxBucket && _serverRxBucket->isLimited())
+        cap = cap ? std::min(cap, _serverRxBucket->burst()) : _serverRxBucket->burst();
+    _socket->setReadBufferSize(qint64(cap));
 }
 
-void SocketWorker::setNoDelay(bool value)
+void SocketWorker::updateThrottle()
 {
-    if(value != _noDelay)
+    const auto rx = _rxPaused;
+    const auto tx = !_pacedData.isEmpty();
+    if(rx == _rxThrottled && tx == _txThrottled)
+        return;
+
+    _rxThrottled = rx;
+    _txThrottled = tx;
+    Q_EMIT throttleChanged(rx, tx);
+}
+
+void SocketWorker::clearRateLimitState()
+{
+    if(_pacingTimerId)
     {
-        _noDelay = value;
-        applyNoDelayOption();
+        TimerWheel::instance()->stop(_pacingTimerId);
+        _pacingTimerId = 0;
     }
+    if(_rxResumeTimerId)
+    {
+        TimerWheel::instance()->stop(_rxResumeTimerId);
+        _rxResumeTimerId = 0;
+    }
+    // Paced bytes are lost with the socket buffer
+    _queuedBytes -= _pacedData.size();
+    _pacedData.clear();
+    _rxPaused = false;
+    updateThrottle();
 }
 
-void SocketWorker::applyNoDelayOption() const
+void SocketWorker::flushOutboundQueue()
 {
-    if(_socket)
+    dropExpiredOutbound();
+    if(_outboundQueue.empty())
+        return;
+
+    LOG_DEV_DEBUG("Flush {} queued messages ({} bytes)", _outboundQueue.size(), _outboundQueueBytes);
+
+    QByteArray batch;
+    batch.reserve(int(_outboundQueueBytes));
+    for(auto& message: _outboundQueue)
     {
-        _socket->setSocketOption(QAbstractSocket::LowDelayOption, _noDelay);
+        batch.append(message.data);
+        _inFlight.push_back(std::move(message));
     }
+    // write count them again
+    _queuedBytes -= qint64(_outboundQueueBytes);
+    _outboundQueue.clear();
+    _outboundQueueBytes = 0;
+
+    _flushingOutbound = true;
+    write(batch.constData(), std::size_t(batch.size()));
+    _flushingOutbound = false;
 }
 
-void SocketWorker::stopWatchdog()
+void SocketWorker::requeueInFlight()
 {
-    if(_watchdog)
+    if(_inFlight.empty())
+        return;
+
+    // Partially written messages are sent again whole, the peer lost the previous connection anyway
+    const auto now = _outboundClock.elapsed();
+    for(auto it = _inFlight.rbegin(); it != _inFlight.rend(); ++it)
     {
-        disconnect(_watchdog, &QTimer::timeout, this, nullptr);
-        _watchdog->deleteLater();
-        _watchdog = nullptr;
+        if(it->data.isEmpty())
+            continue;
+        it->time = now;
+        _outboundQueueBytes += quint64(it->size);
+        _queuedBytes += it->size;
+        _outboundQueue.push_front(std::move(*it));
     }
+    _inFlight.clear();
+    _inFlightWritten = 0;
+    trimOutboundQueue();
 }
 
-void SocketWorker::startBytesCounter()
+void SocketWorker::clearOutboundQueue()
 {
-    if(_bytesCounterTimer)
+    _queuedBytes -= qint64(_outboundQueueBytes);
+    _outboundQueue.clear();
+    _outboundQueueBytes = 0;
+    _inFlight.clear();
+    _inFlightWritten = 0;
+}
+
+void SocketWorker::onSocketError(const QAbstractSocket::SocketError e)
+{
+    // todo : use our own error type
+    if(_socket)
+    {
+        LOG_ERR_THROTTLED_BY(int(e), "Socket Error ({}) : {}", int(e), qPrintable(_socket->errorString()));
+    }
+    else
+    {
+        LOG_ERR_THROTTLED_BY(int(e), "Socket Error ({})", int(e));
+    }
+    Q_EMIT socketError(int(e), _socket ? _socket->errorString() : QStringLiteral("Invalid Socket"));
+    releaseConnectSlot();
+
+    if(e == QAbstractSocket::SocketError::ConnectionRefusedError)
+    {
+        closeAndRestart();
+    }
+}
+
+void SocketWorker::onSocketStateChanged(QAbstractSocket::SocketState socketState)
+{
+    LOG_DEBUG_THROTTLED_BY(int(socketState), "New Socket state : {}", (int)socketState);
+    if(socketState == QAbstractSocket::UnconnectedState)
+    {
+        releaseConnectSlot();
+        onDisconnected();
+    }
+}
+
+void SocketWorker::onConnected()
+{
+    // Avoid nested call with connections
+    if(_isConnected)
+        return;
+    _isConnected = true;
+
+    Q_ASSERT(_socket);
+    NETTCP_TRACE_INSTANT("socket", "startSuccess", this);
+    newRecordConnection();
+    stopWatchdog();
+    releaseConnectSlot();
+    _reconnectPolicy.reset();
+    LOG_INFO("Socket is connected to {}:{}", qPrintable(_socket->peerAddress().toString()), _socket->peerPort());
+    Q_EMIT startSuccess(_socket ? _socket->peerAddress().toString() : "", _socket ? _socket->peerPort() : 0,
+        _socket ? _socket->localAddress().toString() : "", _socket ? _socket->localPort() : 0);
+    Q_EMIT connectionChanged(true);
+
+    startBytesCounter();
+    startTcpInfoSampling();
+    startIdleTimer();
+    applyReadBufferSize();
+    resetHeartbeatRtt();
+    startHeartbeat();
+    startReadCoalescing();
+    flushOutboundQueue();
+}
+
+void SocketWorker::onDisconnected()
+{
+    // Avoid nested call with connections
+    if(!_isConnected)
+        return;
+    _isConnected = false;
+
+    if(_socket)
+    {
+        LOG_INFO("Socket disconnected from {}:{}", qPrintable(_socket->peerAddress().toString()), _socket->peerPort());
+    }
+    Q_EMIT connectionChanged(false);
+    if(!_socketDescriptor)
+        closeAndRestart();
+
+    stopIdleTimer();
+    stopBytesCounter();
+    stopTcpInfoSampling();
+    stopHeartbeat();
+    stopReadCoalescing();
+}
+
+bool SocketWorker::isConnected() const { return _socket && _socket->state() == QAbstractSocket::ConnectedState; }
+
+void SocketWorker::onDataAvailable() { LOG_DEV_WARN("You need to override onDataAvailable"); }
+
+void SocketWorker::onReadyRead()
+{
+    NETTCP_TRACE_SCOPE("socket", "read", this, std::uint64_t(bytesAvailable()));
+    onReadCoalesced();
+    if(_socketOptions.quickAck)
+        SocketOptions::rearmQuickAck(_socket->socketDescriptor());
+    // Unread bytes wait in the capped socket buffer until the rx bucket refill
+    if(_rxPaused)
+        return;
+    if(isRxLimited() && rxTokens() <= 0)
+    {
+        pauseRx();
+        return;
+    }
+    dispatchRead();
+}
+
+std::size_t SocketWorker::bytesAvailable() const
+{
+    if(!_socket)
+        return 0;
+
+    // Handlers read until bytesAvailable is 0, the budget end their loop
+    auto available = std::size_t(_socket->bytesAvailable());
+    if(_readDispatching && _readBudget)
+        available = std::min(available, std::size_t(_readBudgetLeft));
+    return _receiveBuffer.size() + available;
+}
+
+std::size_t SocketWorker::read(std::uint8_t* data, std::size_t maxLen)
+{
+    return read(reinterpret_cast<char*>(data), maxLen);
+}
+
+std::size_t SocketWorker::read(char* data, std::size_t maxLen)
+{
+    if(!_socket)
+        LOG_DEV_WARN("Don't call read when socket is null. Check with isConnected().");
+
+    // Bytes already moved to the receive buffer by peek come first
+    std::size_t buffered = 0;
+    if(!_receiveBuffer.isEmpty())
+    {
+        buffered = std::min(maxLen, _receiveBuffer.size());
+        std::memcpy(data, _receiveBuffer.view().data, buffered);
+        _receiveBuffer.consume(buffered);
+        data += buffered;
+        maxLen -= buffered;
+    }
+
+    if(_readDispatching && _readBudget)
+        maxLen = std::min(maxLen, std::size_t(_readBudgetLeft));
+
+    const auto byteRead = _socket && maxLen ? _socket->read(data, qint64(maxLen)) : 0;
+    if(byteRead > 0)
+        onBytesRead(data, std::size_t(byteRead));
+    return buffered + std::size_t(std::max<qint64>(byteRead, 0));
+}
+
+ByteView SocketWorker::peek()
+{
+    fillReceiveBuffer();
+    return _receiveBuffer.view();
+}
+
+ByteView SocketWorker::readView(std::size_t maxLen)
+{
+    auto view = peek();
+    view.size = std::min(view.size, maxLen);
+    _receiveBuffer.consume(view.size);
+    return view;
+}
+
+void SocketWorker::consume(std::size_t length) { _receiveBuffer.consume(length); }
+
+void SocketWorker::fillReceiveBuffer()
+{
+    if(!_socket)
+        return;
+
+    auto length = std::size_t(_socket->bytesAvailable());
+    if(_readDispatching && _readBudget)
+        length = std::min(length, std::size_t(_readBudgetLeft));
+    if(!length)
+        return;
+
+    // QTcpSocket copy from its own buffer, the only copy until the handler use the bytes
+    auto* data = reinterpret_cast<char*>(_receiveBuffer.prepare(length));
+    const auto byteRead = _socket->read(data, qint64(length));
+    if(byteRead <= 0)
+        return;
+
+    _receiveBuffer.commit(std::size_t(byteRead));
+    onBytesRead(data, std::size_t(byteRead));
+}
+
+void SocketWorker::onBytesRead(const char* data, std::size_t length)
+{
+    if(_readDispatching && _readBudget)
+        _readBudgetLeft -= std::min(quint64(length), _readBudgetLeft);
+    // Activity of a dispatch is known once its control bytes are
+    if(_readDispatching)
+        _dispatchBytesRead += length;
+    else
+        onActivity();
+    _rxBytesCounter += length;
+    consumeRx(length);
+    if(_recorder)
+        _recorder->record(_recordConnection, TrafficRecorder::Direction::Rx, data, length);
+}
+
+void SocketWorker::setReadBudget(quint64 value) { _readBudget = value; }
+
+void SocketWorker::dispatchRead()
+{
+    const auto start = _readClock.nsecsElapsed();
+    if(_readRequeued)
+    {
+        _readRequeued = false;
+        _readRequeueLatencyMax = std::max(_readRequeueLatencyMax, quint64(start - _readRequeuedAt) / 1000);
+    }
+
+    _readBudgetLeft = _readBudget;
+    _readDispatching = true;
+    onDataAvailable();
+    _readDispatching = false;
+
+    // Heartbeats alone don't wake a parked connection
+    if(_dispatchBytesRead > _dispatchControlBytes)
+        onActivity();
+    _dispatchBytesRead = 0;
+    _dispatchControlBytes = 0;
+
+    _readDispatchTimeMax = std::max(_readDispatchTimeMax, quint64(_readClock.nsecsElapsed() - start) / 1000);
+
+    // readyRead isn't emitted again for bytes already buffered, and other sockets of the thread read first
+    if(_readBudget && !_readBudgetLeft && _socket && _socket->bytesAvailable())
+        requeueRead();
+}
+
+void SocketWorker::requeueRead()
+{
+    if(_readRequeued)
+        return;
+
+    _readRequeued = true;
+    _readRequeuedAt = _readClock.nsecsElapsed();
+    ++_readBudgetExceededCounter;
+    QMetaObject::invokeMethod(
+        this,
+        [this]()
+        {
+            // Already dispatched by a readyRead, or closed
+            if(_readRequeued && _socket)
+                onReadyRead();
+        },
+        Qt::QueuedConnection);
+}
+
+void SocketWorker::reportReadStats()
+{
+    // Maxima are per period, report once more when they fall back to 0
+    const bool hasStats = _readBudgetExceededCounter || _readDispatchTimeMax || _readRequeueLatencyMax;
+    if(!hasStats && !_readStatsReported)
+        return;
+
+    Q_EMIT readStatsUpdated(_readBudgetExceededCounter, _readDispatchTimeMax, _readRequeueLatencyMax);
+    _readStatsReported = hasStats;
+    _readBudgetExceededCounter = 0;
+    _readDispatchTimeMax = 0;
+    _readRequeueLatencyMax = 0;
+}
+
+void SocketWorker::setReadLowWatermark(int value)
+{
+    _readLowWatermark = std::max(value, 0);
+    if(!_isConnected)
+        return;
+
+    stopReadCoalescing();
+    // Back to the system default of 1 byte
+    if(!_readLowWatermark && _socket)
+        SocketOptions::setReceiveLowWatermark(_socket->socketDescriptor(), 1);
+    startReadCoalescing();
+}
+
+void SocketWorker::setReadMaxDelay(quint64 value)
+{
+    _readMaxDelay = value;
+    if(_isConnected)
+    {
+        stopReadCoalescing();
+        startReadCoalescing();
+    }
+}
+
+void SocketWorker::startReadCoalescing()
+{
+    if(_readLowWatermark <= 1 || !_socket || _readCoalescingTimerId)
+        return;
+
+    if(!SocketOptions::setReceiveLowWatermark(_socket->socketDescriptor(), _readLowWatermark))
+    {
+        LOG_DEV_WARN("SO_RCVLOWAT isn't supported on this platform, readyRead aren't coalesced");
+        return;
+    }
+
+    // Without the timer, bytes below the watermark would wait for the next bytes
+    if(!_readMaxDelay)
+        return;
+
+    // One repeated entry in the 1 ms wheel shared by the thread, reads only mark it
+    _readSinceCheck = false;
+    _readCoalescingTimerId = TimerWheel::instance(readCoalescingResolution)
+                                 ->start(int(_readMaxDelay), this, [this]() { onReadCoalescingTimeout(); }, true);
+}
+
+void SocketWorker::stopReadCoalescing()
+{
+    _readFlushing = false;
+    if(!_readCoalescingTimerId)
+        return;
+
+    TimerWheel::instance(readCoalescingResolution)->stop(_readCoalescingTimerId);
+    _readCoalescingTimerId = 0;
+}
+
+void SocketWorker::onReadCoalescingTimeout()
+{
+    if(!_socket || _readFlushing)
+        return;
+
+    // Read during the last period, the socket isn't silent
+    if(_readSinceCheck)
+    {
+        _readSinceCheck = false;
+        return;
+    }
+
+    // An ioctl per readMaxDelay ms of silence, instead of a wakeup per segment
+    if(SocketOptions::kernelBytesAvailable(_socket->socketDescriptor()) > 0)
+    {
+        _readFlushing = SocketOptions::setReceiveLowWatermark(_socket->socketDescriptor(), 1);
+        NETTCP_TRACE_INSTANT("socket", "readFlush", this);
+    }
+}
+
+void SocketWorker::onReadCoalesced()
+{
+    if(!_readCoalescingTimerId)
+        return;
+
+    if(_readFlushing)
+    {
+        SocketOptions::setReceiveLowWatermark(_socket->socketDescriptor(), _readLowWatermark);
+        _readFlushing = false;
+    }
+    _readSinceCheck = true;
+}
+
+void SocketWorker::setConnectTimeout(quint64 value) { _connectTimeout = value; }
+
+void SocketWorker::setConnectAttemptDelay(quint64 value) { _connectAttemptDelay = value; }
+
+void SocketWorker::connectToHost()
+{
+    if(_connectTimeout)
+        _connectTimerId = TimerWheel::instance()->start(int(_connectTimeout), this, [this]() { onConnectTimeout(); });
+
+    QHostAddress address;
+    if(address.setAddress(_address))
+    {
+        connectToAddresses({address});
+        return;
+    }
+
+    QList<QHostAddress> addresses;
+    if(HostCache::instance().lookup(_address, addresses))
+    {
+        connectToAddresses(addresses);
+        return;
+    }
+
+    const auto generation = _connectGeneration;
+    _hostLookupId = QHostInfo::lookupHost(_address, this,
+        [this, generation](const QHostInfo& info)
+        {
+            // Result of an aborted connection
+            if(generation != _connectGeneration)
+                return;
+            _hostLookupId = -1;
+            onHostResolved(info);
+        });
+}
+
+void SocketWorker::onHostResolved(const QHostInfo& info)
+{
+    if(info.error() != QHostInfo::NoError || info.addresses().isEmpty())
+    {
+        LOG_ERR_THROTTLED("Fail to resolve {} : {}", qPrintable(_address), qPrintable(info.errorString()));
+        Q_EMIT socketError(int(QAbstractSocket::HostNotFoundError), info.errorString());
+        closeAndRestart();
+        return;
+    }
+
+    HostCache::instance().insert(_address, info.addresses());
+    connectToAddresses(info.addresses());
+}
+
+void SocketWorker::connectToAddresses(const QList<QHostAddress>& addresses)
+{
+    // Happy Eyeballs (RFC 8305) : alternate address families, starting with the first one given by the resolver
+    QList<QHostAddress> preferred;
+    QList<QHostAddress> other;
+    for(const auto& address: addresses)
+    {
+        if(address.protocol() == addresses.first().protocol())
+            preferred.append(address);
+        else
+            other.append(address);
+    }
+
+    _pendingAddresses.clear();
+    while(!preferred.isEmpty() || !other.isEmpty())
+    {
+        if(!preferred.isEmpty())
+            _pendingAddresses.append(preferred.takeFirst());
+        if(!other.isEmpty())
+            _pendingAddresses.append(other.takeFirst());
+    }
+
+    startNextAttempt();
+}
+
+void SocketWorker::startNextAttempt()
+{
+    if(_attemptTimerId)
+    {
+        TimerWheel::instance()->stop(_attemptTimerId);
+        _attemptTimerId = 0;
+    }
+    if(_pendingAddresses.isEmpty())
+        return;
+
+    const auto address = _pendingAddresses.takeFirst();
+    auto* attempt = new QTcpSocket(this);
+    if(!_slimMode)
+        attempt->setObjectName("socket");
+    _attempts.push_back(attempt);
+
+    connect(attempt, &QTcpSocket::connected, this, [this, attempt]() { onAttemptConnected(attempt); });
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+    connect(attempt, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this,
+        [this, attempt]() { onAttemptFailed(attempt); });
+#else
+    connect(attempt, &QAbstractSocket::errorOccurred, this, [this, attempt]() { onAttemptFailed(attempt); });
+#endif
+
+    LOG_DEV_DEBUG("Connect to {}:{}", qPrintable(address.toString()), int(_port));
+    attempt->connectToHost(address, _port);
+
+    // Don't wait for the system timeout of an unresponsive address before trying the next one
+    if(!_pendingAddresses.isEmpty() && _connectAttemptDelay)
+    {
+        _attemptTimerId = TimerWheel::instance()->start(int(_connectAttemptDelay), this,
+            [this]()
+            {
+                _attemptTimerId = 0;
+                startNextAttempt();
+            });
+    }
+}
+
+void SocketWorker::onAttemptConnected(QTcpSocket* attempt)
+{
+    const auto it = std::find(_attempts.begin(), _attempts.end(), attempt);
+    if(it == _attempts.end())
+        return;
+    _attempts.erase(it);
+    disconnect(attempt, nullptr, this, nullptr);
+
+    // First connected win, abort the others
+    abortConnectAttempts();
+
+    Q_ASSERT(!_socket);
+    _socket = attempt;
+    connectSocketSignals();
+    applyNoDelayOption();
+    applySocketOptions();
+    onConnected();
+}
+
+void SocketWorker::onAttemptFailed(QTcpSocket* attempt)
+{
+    const auto it = std::find(_attempts.begin(), _attempts.end(), attempt);
+    if(it == _attempts.end())
+        return;
+    _attempts.erase(it);
+
+    const auto error = attempt->error();
+    const auto description = attempt->errorString();
+    disconnect(attempt, nullptr, this, nullptr);
+    attempt->abort();
+    attempt->deleteLater();
+    LOG_DEBUG_THROTTLED_BY(int(error), "Connection attempt failed ({}) : {}", int(error), qPrintable(description));
+
+    if(!_pendingAddresses.isEmpty())
+    {
+        startNextAttempt();
+        return;
+    }
+    // Other attempts are still running
+    if(!_attempts.empty())
+        return;
+
+    LOG_ERR_THROTTLED_BY(int(error), "Socket Error ({}) : {}", int(error), qPrintable(description));
+    Q_EMIT socketError(int(error), description);
+    // Resolve again on next attempt, addresses might be outdated
+    HostCache::instance().remove(_address);
+    closeAndRestart();
+}
+
+void SocketWorker::onConnectTimeout()
+{
+    _connectTimerId = 0;
+    LOG_ERR_THROTTLED("Connection to {}:{} timed out after {} ms", qPrintable(_address), int(_port), _connectTimeout);
+    Q_EMIT socketError(int(QAbstractSocket::SocketTimeoutError), QStringLiteral("Connection timed out"));
+    closeAndRestart();
+}
+
+void SocketWorker::abortConnectAttempts()
+{
+    ++_connectGeneration;
+    if(_hostLookupId >= 0)
+    {
+        QHostInfo::abortHostLookup(_hostLookupId);
+        _hostLookupId = -1;
+    }
+    if(_connectTimerId)
+    {
+        TimerWheel::instance()->stop(_connectTimerId);
+        _connectTimerId = 0;
+    }
+    if(_attemptTimerId)
+    {
+        TimerWheel::instance()->stop(_attemptTimerId);
+        _attemptTimerId = 0;
+    }
+    _pendingAddresses.clear();
+
+    for(auto* attempt: _attempts)
+    {
+        disconnect(attempt, nullptr, this, nullptr);
+        attempt->abort();
+        attempt->deleteLater();
+    }
+    _attempts.clear();
+}
+
+void SocketWorker::onWatchdogPeriodChanged(quint64 period)
+{
+    _watchdogPeriod = period;
+    _reconnectPolicy.setInitialDelay(period);
+    // Restart the watchdog with new period
+    if(_watchdog && _watchdog->isActive())
+    {
+        stopWatchdog();
+        closeAndRestart();
+    }
+}
+
+void SocketWorker::onWatchdogTimeout()
+{
+    NETTCP_TRACE_INSTANT("socket", "watchdog", this);
+    // Try to restart the server, or start watchdog
+    onStart();
+}
+
+void SocketWorker::closeAndRestart()
+{
+    if(!_isRunning)
+        return;
+
+    NETTCP_TRACE_INSTANT("socket", "closeAndRestart", this);
+
+    // Don't restart again
+    if(_watchdog && _watchdog->isActive())
+    {
+        LOG_INFO_THROTTLED("Socket Restart timer is already running. Remaining time "
+                           "before restart : {} ms",
+            _watchdog->remainingTime());
+        return;
+    }
+
+    closeSocket();
+
+    // Can't restart a socket descriptor based socket
+    // Just need to wait for the parent to kill it
+    if(_socketDescriptor)
+    {
+        LOG_DEV_DEBUG("Don't start watchdog for worker, because it have been "
+                      "created with a socketDescriptor. Please kill this socket worker from owner");
+        return;
+    }
+
+    if(!_watchdog)
+    {
+        _watchdog = new QTimer(this);
+        _watchdog->setObjectName("watchdog");
+        LOG_DEV_DEBUG("Allocate watchdog {}", static_cast<void*>(_watchdog));
+
+        connect(_watchdog, &QTimer::timeout, this, &SocketWorker::onWatchdogTimeout);
+        _watchdog->setTimerType(Qt::VeryCoarseTimer);
+        _watchdog->setSingleShot(true);
+    }
+    const auto delay = _reconnectPolicy.nextDelay();
+    _watchdog->start(int(delay));
+    LOG_INFO_THROTTLED("Close and try to restart socket in {} ms (attempt {})", delay, _reconnectPolicy.attempts());
+}
+
+void SocketWorker::setReconnectMultiplier(qreal value) { _reconnectPolicy.setMultiplier(value); }
+
+void SocketWorker::setReconnectMaxDelay(quint64 value) { _reconnectPolicy.setMaxDelay(value); }
+
+void SocketWorker::setReconnectJitter(int value)
+{
+    _reconnectPolicy.setJitter(ReconnectPolicy::Jitter(std::min(std::max(value, 0), 2)));
+}
+
+const int SocketWorker::heartbeatSize;
+
+void SocketWorker::setHeartbeatPeriod(quint64 value)
+{
+    _heartbeatPeriod = value;
+    if(_isConnected)
+        startHeartbeat();
+}
+
+void SocketWorker::setHeartbeatMaxMissed(int value) { _heartbeatMaxMissed = std::max(value, 0); }
+
+bool SocketWorker::writeHeartbeat(const QByteArray&) { return false; }
+
+bool SocketWorker::onHeartbeatReceived(const QByteArray& heartbeat)
+{
+    if(heartbeat.size() != heartbeatSize)
+        return false;
+
+    const auto kind = HeartbeatKind(heartbeat.at(0));
+    const auto time = qFromBigEndian<quint64>(heartbeat.constData() + 1);
+    switch(kind)
+    {
+    case HeartbeatKind::Ping:
+        // Always answer, even when our own heartbeat is disabled
+        writeHeartbeat(encodeHeartbeat(HeartbeatKind::Pong, time));
+        return true;
+    case HeartbeatKind::Pong: break;
+    default: return false;
+    }
+
+    _heartbeatPending = false;
+    _heartbeatMissed = 0;
+
+    const auto now = heartbeatClock();
+    const auto rtt = now > time ? now - time : 0;
+    if(!_heartbeatSrtt)
+    {
+        _heartbeatSrtt = std::max<quint64>(rtt, 1);
+        _heartbeatRttVar = rtt / 2;
+    }
+    else
+    {
+        const auto delta = _heartbeatSrtt > rtt ? _heartbeatSrtt - rtt : rtt - _heartbeatSrtt;
+        _heartbeatRttVar = (3 * _heartbeatRttVar + delta) / 4;
+        _heartbeatSrtt = std::max<quint64>((7 * _heartbeatSrtt + rtt) / 8, 1);
+    }
+    Q_EMIT heartbeatUpdated(_heartbeatSrtt, _heartbeatRttVar);
+    return true;
+}
+
+void SocketWorker::startHeartbeat()
+{
+    stopHeartbeat();
+    if(!_heartbeatPeriod)
+        return;
+
+    // One repeated entry in the thread TimerWheel, not a timer per connection
+    _heartbeatTimerId =
+        TimerWheel::instance()->start(int(_heartbeatPeriod), this, [this]() { onHeartbeatTick(); }, true);
+}
+
+void SocketWorker::stopHeartbeat()
+{
+    if(_heartbeatTimerId)
+    {
+        TimerWheel::instance()->stop(_heartbeatTimerId);
+        _heartbeatTimerId = 0;
+    }
+    _heartbeatPending = false;
+    _heartbeatMissed = 0;
+}
+
+void SocketWorker::resetHeartbeatRtt()
+{
+    // Round trip of a previous connection says nothing about this one, the first pong seed it again
+    if(!_heartbeatSrtt && !_heartbeatRttVar)
+        return;
+    _heartbeatSrtt = 0;
+    _heartbeatRttVar = 0;
+    Q_EMIT heartbeatUpdated(0, 0);
+}
+
+void SocketWorker::onHeartbeatTick()
+{
+    if(!isConnected())
+        return;
+
+    if(_heartbeatPending && _heartbeatMaxMissed && ++_heartbeatMissed >= _heartbeatMaxMissed)
+    {
+        LOG_WARN("No heartbeat answer for {} periods of {} ms, close the connection", _heartbeatMissed,
+            _heartbeatPeriod);
+        closeAndRestart();
+        return;
+    }
+
+    if(!writeHeartbeat(encodeHeartbeat(HeartbeatKind::Ping, heartbeatClock())))
+    {
+        LOG_WARN("Worker can't write heartbeats out of band of its data, disable heartbeat");
+        stopHeartbeat();
+        return;
+    }
+    _heartbeatPending = true;
+}
+
+QByteArray SocketWorker::encodeHeartbeat(HeartbeatKind kind, quint64 time)
+{
+    QByteArray heartbeat(heartbeatSize, Qt::Uninitialized);
+    heartbeat[0] = char(kind);
+    qToBigEndian(time, heartbeat.data() + 1);
+    return heartbeat;
+}
+
+void SocketWorker::releaseConnectSlot()
+{
+    _connectSlotGranted = false;
+    if(!_connectTicket)
+        return;
+    ReconnectScheduler::instance().release(_connectTicket);
+    _connectTicket = 0;
+}
+
+void SocketWorker::setNoDelay(bool value)
+{
+    if(value != _noDelay)
+    {
+        _noDelay = value;
+        applyNoDelayOption();
+    }
+}
+
+void SocketWorker::applyNoDelayOption() const
+{
+    if(_socket)
+    {
+        _socket->setSocketOption(QAbstractSocket::LowDelayOption, _noDelay);
+    }
+}
+
+void SocketWorker::stopWatchdog()
+{
+    if(_watchdog)
+    {
+        disconnect(_watchdog, &QTimer::timeout, this, nullptr);
+        _watchdog->deleteLater();
+        _watchdog = nullptr;
+    }
+}
+
+void SocketWorker::startBytesCounter()
+{
+    if(_bytesCounterTimer || _bytesCounterTimerId)
     {
         LOG_DEV_ERR("_bytesCounterTimer is valid at startBytesCounter called");
         stopBytesCounter();
@@ -351,6 +1536,12 @@ void SocketWorker::startBytesCounter()
     // Should only be called if _bytesCounterTimer is nullptr
     Q_ASSERT(!_bytesCounterTimer);
 
+    if(_slimMode)
+    {
+        _bytesCounterTimerId = TimerWheel::instance()->start(1000, this, [this]() { updateDataCounter(); }, true);
+        return;
+    }
+
     _bytesCounterTimer = new QTimer(this);
     _bytesCounterTimer->setObjectName("bytesCounter");
     _bytesCounterTimer->setSingleShot(false);
@@ -363,6 +1554,8 @@ void SocketWorker::stopBytesCounter()
 {
     Q_EMIT bytesReceived(_rxBytesCounter);
     Q_EMIT bytesSent(_txBytesCounter);
+    reportConflation();
+    reportReadStats();
 
     if(_rxBytesCounter)
     {
@@ -381,6 +1574,11 @@ void SocketWorker::stopBytesCounter()
         _bytesCounterTimer->deleteLater();
         _bytesCounterTimer = nullptr;
     }
+    if(_bytesCounterTimerId)
+    {
+        TimerWheel::instance()->stop(_bytesCounterTimerId);
+        _bytesCounterTimerId = 0;
+    }
 }
 
 void SocketWorker::updateDataCounter()
@@ -389,4 +1587,207 @@ void SocketWorker::updateDataCounter()
     Q_EMIT bytesSent(_txBytesCounter);
     _rxBytesCounter = 0;
     _txBytesCounter = 0;
+    reportConflation();
+    reportReadStats();
+}
+
+void SocketWorker::setIdleTimeout(quint64 timeout)
+{
+    if(timeout == _idleTimeout)
+        return;
+
+    // Restore the bytes counter before changing the policy
+    if(_parked)
+        onActivity();
+    _idleTimeout = timeout;
+    stopIdleTimer();
+    if(_isConnected)
+        startIdleTimer();
+}
+
+std::size_t SocketWorker::releaseIdleBuffers()
+{
+    auto released = _receiveBuffer.release();
+
+    // Capacity of the last paced write is kept by QByteArray
+    if(_pacedData.isEmpty() && _pacedData.capacity())
+    {
+        released += std::size_t(_pacedData.capacity());
+        _pacedData = QByteArray();
+    }
+
+    // Buckets stay allocated after the last held key is written. An empty map doesn't allocate
+    if(_conflationQueue.empty() && _conflationQueue.bucket_count() > 1)
+    {
+        released += _conflationQueue.bucket_count() * sizeof(void*);
+        decltype(_conflationQueue)().swap(_conflationQueue);
+    }
+    return released;
+}
+
+void SocketWorker::startIdleTimer()
+{
+    if(!_idleTimeout || _idleTimerId)
+        return;
+
+    // A connection is parked after one or two periods without traffic.
+    // Checking a flag avoids reading a clock on every read and write.
+    _activity = false;
+    _idleTimerId = TimerWheel::instance()->start(int(_idleTimeout), this, [this]() { checkIdle(); }, true);
+}
+
+void SocketWorker::stopIdleTimer()
+{
+    if(_idleTimerId)
+    {
+        TimerWheel::instance()->stop(_idleTimerId);
+        _idleTimerId = 0;
+    }
+    if(_parked)
+    {
+        _parked = false;
+        Q_EMIT idleChanged(false);
+    }
+}
+
+void SocketWorker::checkIdle()
+{
+    if(_activity)
+    {
+        _activity = false;
+        return;
+    }
+    park();
+}
+
+void SocketWorker::park()
+{
+    // Data waiting to be read or sent isn't idle
+    if(_parked || !_isConnected || !_socket || _socket->bytesAvailable() || bytesToWrite())
+        return;
+
+    NETTCP_TRACE_INSTANT("socket", "park", this);
+    _parked = true;
+    stopBytesCounter();
+    const auto released = releaseIdleBuffers();
+    LOG_DEV_DEBUG("Park idle connection, {} bytes released", released);
+    Q_EMIT idleChanged(true);
+    if(released)
+        Q_EMIT idleBuffersReleased(released);
+}
+
+void SocketWorker::onActivity()
+{
+    _activity = true;
+    if(!_parked)
+        return;
+
+    NETTCP_TRACE_INSTANT("socket", "unpark", this);
+    _parked = false;
+    startBytesCounter();
+    Q_EMIT idleChanged(false);
+}
+
+void SocketWorker::setMonitorEventLoop(bool value)
+{
+    if(value != _monitorEventLoop)
+    {
+        _monitorEventLoop = value;
+        applyMonitorEventLoop();
+    }
+}
+
+void SocketWorker::applyMonitorEventLoop()
+{
+    if(_monitorEventLoop && _isRunning)
+    {
+        if(_eventLoopMonitor)
+            return;
+
+        // One monitor per thread, whatever the count of sockets served by the thread
+        _eventLoopMonitor = EventLoopMonitor::forCurrentThread();
+        LOG_DEV_DEBUG("Use event loop monitor {}", static_cast<void*>(_eventLoopMonitor.get()));
+        connect(_eventLoopMonitor.get(), &EventLoopMonitor::statsUpdated, this, &SocketWorker::eventLoopStatsUpdated);
+    }
+    else if(_eventLoopMonitor)
+    {
+        disconnect(_eventLoopMonitor.get(), nullptr, this, nullptr);
+        _eventLoopMonitor.reset();
+        Q_EMIT eventLoopStatsUpdated(0, 0, 0);
+    }
+}
+
+void SocketWorker::setTcpInfoPeriod(quint64 period)
+{
+    if(period == _tcpInfoPeriod)
+        return;
+
+    _tcpInfoPeriod = period;
+    stopTcpInfoSampling();
+    if(_isConnected)
+        startTcpInfoSampling();
+}
+
+void SocketWorker::startTcpInfoSampling()
+{
+    if(!_tcpInfoPeriod || _tcpInfoTimer)
+        return;
+
+    if(!TcpInfo::isSupported())
+    {
+        LOG_DEV_WARN("TCP_INFO sampling isn't supported on this platform");
+        return;
+    }
+
+    // getsockopt is a syscall, don't let a small period flood the worker
+    static const quint64 minPeriod = 100;
+
+    _tcpInfoTimer = new QTimer(this);
+    _tcpInfoTimer->setObjectName("tcpInfo");
+    _tcpInfoTimer->setTimerType(Qt::CoarseTimer);
+    _tcpInfoTimer->setInterval(int(std::max(_tcpInfoPeriod, minPeriod)));
+    connect(_tcpInfoTimer, &QTimer::timeout, this, &SocketWorker::sampleTcpInfo);
+    _tcpInfoTimer->start();
+    sampleTcpInfo();
+}
+
+void SocketWorker::stopTcpInfoSampling()
+{
+    if(!_tcpInfoTimer)
+        return;
+
+    disconnect(_tcpInfoTimer, &QTimer::timeout, this, nullptr);
+    _tcpInfoTimer->deleteLater();
+    _tcpInfoTimer = nullptr;
+    Q_EMIT tcpInfoUpdated(0, 0, 0, 0, 0, 0);
+}
+
+void SocketWorker::sampleTcpInfo()
+{
+    if(!_socket)
+        return;
+
+    TcpInfo info;
+    if(!TcpInfo::read(_socket->socketDescriptor(), info))
+        return;
+
+    Q_EMIT tcpInfoUpdated(info.rtt, info.rttVariance, info.congestionWindow, info.retransmits, info.unackedSegments,
+        info.sendQueueBytes);
+}
+
+void SocketWorker::setTrafficRecorder(std::shared_ptr<TrafficRecorder> recorder)
+{
+    QMetaObject::invokeMethod(this,
+        [this, recorder]()
+        {
+            _recorder = recorder;
+            if(_isConnected)
+                newRecordConnection();
+        });
+}
+
+void SocketWorker::newRecordConnection()
+{
+    // Each tcp connection get a new id, so replay can reconnect like the original peer did
+    _recordConnection = _recorder ? _recorder->newConnectionId() : 0;
 }
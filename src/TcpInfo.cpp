@@ -0,0 +1,58 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/TcpInfo.hpp>
+
+#ifdef Q_OS_LINUX
+// Linux Headers
+#    include <linux/sockios.h>
+#    include <netinet/in.h>
+#    include <netinet/tcp.h>
+#    include <sys/ioctl.h>
+#    include <sys/socket.h>
+#endif
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+bool TcpInfo::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool TcpInfo::read(qintptr socketDescriptor, TcpInfo& info)
+{
+#ifdef Q_OS_LINUX
+    if(socketDescriptor < 0)
+        return false;
+
+    const auto fd = int(socketDescriptor);
+
+    struct tcp_info kernelInfo = {};
+    socklen_t length = sizeof(kernelInfo);
+    if(::getsockopt(fd, IPPROTO_TCP, TCP_INFO, &kernelInfo, &length) != 0)
+        return false;
+
+    info.rtt = kernelInfo.tcpi_rtt;
+    info.rttVariance = kernelInfo.tcpi_rttvar;
+    info.congestionWindow = kernelInfo.tcpi_snd_cwnd;
+    info.retransmits = kernelInfo.tcpi_total_retrans;
+    info.unackedSegments = kernelInfo.tcpi_unacked;
+
+    int sendQueue = 0;
+    info.sendQueueBytes = ::ioctl(fd, SIOCOUTQ, &sendQueue) == 0 && sendQueue > 0 ? quint32(sendQueue) : 0;
+
+    return true;
+#else
+    Q_UNUSED(socketDescriptor);
+    Q_UNUSED(info);
+    return false;
+#endif
+}
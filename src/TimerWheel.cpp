@@ -0,0 +1,158 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/TimerWheel.hpp>
+
+// Qt Headers
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+// Stl Headers
+#include <algorithm>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// Timers further than bucketCount ticks wait for their round in their bucket
+static const std::size_t bucketCount = 512;
+
+// Wheels of the calling thread, one per resolution. A wheel remove itself when destroyed
+static thread_local std::vector<TimerWheel*> threadWheels;
+
+// ───── CLASS ─────
+
+TimerWheel::TimerWheel(int resolution, QObject* parent) :
+    QObject(parent), _resolution(std::max(resolution, 1)), _timer(new QTimer(this)), _buckets(bucketCount)
+{
+    // Qt already treat coarse timers of 20 ms or less as precise
+    _timer->setTimerType(Qt::CoarseTimer);
+    _timer->setInterval(_resolution);
+    connect(_timer, &QTimer::timeout, this, &TimerWheel::onTick);
+    _clock.start();
+}
+
+TimerWheel::~TimerWheel()
+{
+    threadWheels.erase(std::remove(threadWheels.begin(), threadWheels.end(), this), threadWheels.end());
+}
+
+TimerWheel* TimerWheel::instance(int resolution)
+{
+    resolution = std::max(resolution, 1);
+    for(auto* wheel: threadWheels)
+    {
+        if(wheel->resolution() == resolution)
+            return wheel;
+    }
+
+    auto* const threadWheel = new TimerWheel(resolution);
+    threadWheels.push_back(threadWheel);
+    // Destroyed with the event loop of its thread, not by a thread_local destructor that can run after
+    // QCoreApplication is gone. The application thread never emit finished, the application own its wheel
+    auto* const app = QCoreApplication::instance();
+    if(app && app->thread() == QThread::currentThread())
+        threadWheel->setParent(app);
+    else
+        connect(QThread::currentThread(), &QThread::finished, threadWheel, &QObject::deleteLater);
+    return threadWheel;
+}
+
+std::uint64_t TimerWheel::elapsedTicks() const { return std::uint64_t(_clock.elapsed()) / std::uint64_t(_resolution); }
+
+void TimerWheel::schedule(Id id, std::uint64_t deadline) { _buckets[deadline % bucketCount].push_back(id); }
+
+TimerWheel::Id TimerWheel::start(int interval, QObject* context, Callback callback, bool repeat)
+{
+    // The tick timer doesn't run while the wheel is empty, catch up with the clock
+    if(_entries.empty())
+        _tick = elapsedTicks();
+
+    const auto resolution = std::uint64_t(_resolution);
+    const auto ticks = std::max<std::uint64_t>(1, (std::uint64_t(std::max(interval, 0)) + resolution - 1) / resolution);
+
+    const auto id = _nextId++;
+    auto& entry = _entries[id];
+    entry.deadline = _tick + ticks;
+    entry.period = repeat ? ticks : 0;
+    entry.context = context;
+    entry.callback = std::move(callback);
+    schedule(id, entry.deadline);
+
+    if(!_timer->isActive())
+        _timer->start();
+    return id;
+}
+
+void TimerWheel::stop(Id id)
+{
+    // Id is lazily removed from its bucket
+    _entries.erase(id);
+    if(_entries.empty())
+        _timer->stop();
+}
+
+bool TimerWheel::isActive(Id id) const { return _entries.find(id) != _entries.end(); }
+
+int TimerWheel::resolution() const { return _resolution; }
+
+std::size_t TimerWheel::size() const { return _entries.size(); }
+
+void TimerWheel::onTick()
+{
+    const auto target = elapsedTicks();
+    std::vector<Id> due;
+
+    // Catch up ticks missed while the event loop was busy
+    while(_tick < target && !_entries.empty())
+    {
+        ++_tick;
+        due.clear();
+        due.swap(_buckets[_tick % bucketCount]);
+
+        for(const auto id: due)
+        {
+            auto it = _entries.find(id);
+            if(it == _entries.end())
+                continue;
+
+            auto& entry = it->second;
+            if(entry.deadline > _tick)
+            {
+                // Not this round
+                schedule(id, entry.deadline);
+                continue;
+            }
+
+            if(!entry.context)
+            {
+                _entries.erase(it);
+                continue;
+            }
+
+            // Callback might start or stop timers, don't keep reference on entry
+            Callback callback;
+            if(entry.period)
+            {
+                // Don't fire missed periods in burst
+                entry.deadline = std::max(entry.deadline + entry.period, _tick + 1);
+                schedule(id, entry.deadline);
+                callback = entry.callback;
+            }
+            else
+            {
+                callback = std::move(entry.callback);
+                _entries.erase(it);
+            }
+            callback();
+        }
+    }
+
+    if(_entries.empty())
+    {
+        _timer->stop();
+        // Buckets only contain stale ids
+        for(auto& bucket: _buckets) bucket.clear();
+    }
+}
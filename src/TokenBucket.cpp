@@ -0,0 +1,85 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/TokenBucket.hpp>
+
+// Stl Headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// ───── CLASS ─────
+
+TokenBucket::TokenBucket(std::uint64_t rate, std::uint64_t burst) { setRate(rate, burst); }
+
+void TokenBucket::setRate(std::uint64_t rate, std::uint64_t burst)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _rate = rate;
+    _burst = burst ? burst : std::max<std::uint64_t>(rate / 10, 4096);
+    // Start full, so a new limit doesn't pause a connection that was idle
+    _tokens = double(_burst);
+    _last = Clock::now();
+}
+
+std::uint64_t TokenBucket::rate() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _rate;
+}
+
+std::uint64_t TokenBucket::burst() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _burst;
+}
+
+std::int64_t TokenBucket::available() { return available(Clock::now()); }
+
+std::int64_t TokenBucket::available(Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(!isLimited())
+        return std::numeric_limits<std::int64_t>::max();
+
+    refill(now);
+    return std::int64_t(std::floor(_tokens));
+}
+
+void TokenBucket::consume(std::uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(isLimited())
+        _tokens -= double(bytes);
+}
+
+std::uint64_t TokenBucket::delayFor(std::uint64_t bytes) { return delayFor(bytes, Clock::now()); }
+
+std::uint64_t TokenBucket::delayFor(std::uint64_t bytes, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto rate = _rate.load();
+    if(!rate)
+        return 0;
+
+    refill(now);
+    // More than burst would never be available
+    const auto needed = double(std::min(bytes, _burst)) - _tokens;
+    if(needed <= 0)
+        return 0;
+    return std::max<std::uint64_t>(std::uint64_t(std::ceil(needed * 1000. / double(rate))), 1);
+}
+
+void TokenBucket::refill(Clock::time_point now)
+{
+    if(now <= _last)
+        return;
+
+    const auto elapsed = std::chrono::duration<double>(now - _last).count();
+    _tokens = std::min(_tokens + elapsed * double(_rate.load()), double(_burst));
+    _last = now;
+}
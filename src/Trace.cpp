@@ -0,0 +1,257 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/Trace.hpp>
+
+// Qt Headers
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+
+// Stl Headers
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+std::atomic<bool> Trace::_enabled {false};
+
+namespace {
+
+struct TraceRing
+{
+    explicit TraceRing(std::size_t size) : events(size), mask(size - 1) {}
+
+    std::vector<Trace::Event> events;
+    const std::size_t mask;
+    // Only written by the owning thread
+    std::atomic<std::uint64_t> head {0};
+    // Events before this index have been cleared
+    std::atomic<std::uint64_t> tail {0};
+    // False when the thread that owned the ring exited. The ring can then be reused by a new thread.
+    std::atomic<bool> owned {true};
+    std::uint64_t threadId = 0;
+    std::string threadName;
+};
+
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+    std::atomic<std::size_t> bufferSize {4096};
+};
+
+TraceRegistry& registry()
+{
+    static TraceRegistry r;
+    return r;
+}
+
+TraceRing* acquireRing()
+{
+    auto& r = registry();
+    const auto size = r.bufferSize.load();
+
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    // Socket worker threads come and go, reuse ring of dead threads to keep memory bounded
+    TraceRing* ring = nullptr;
+    for(const auto& it: r.rings)
+    {
+        bool expected = false;
+        if(it->events.size() == size && it->owned.compare_exchange_strong(expected, true))
+        {
+            ring = it.get();
+            break;
+        }
+    }
+
+    // Events of the dead thread would be exported with the name of the new one
+    if(ring)
+    {
+        std::fill(ring->events.begin(), ring->events.end(), Trace::Event());
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+    }
+
+    if(!ring)
+    {
+        r.rings.emplace_back(new TraceRing(size));
+        ring = r.rings.back().get();
+        ring->threadId = r.rings.size();
+    }
+
+    const auto* thread = QThread::currentThread();
+    ring->threadName = thread && !thread->objectName().isEmpty() ? thread->objectName().toStdString() :
+                                                                   "Thread " + std::to_string(ring->threadId);
+    return ring;
+}
+
+struct TraceRingHolder
+{
+    TraceRing* ring = nullptr;
+    ~TraceRingHolder()
+    {
+        if(ring)
+            ring->owned.store(false, std::memory_order_release);
+    }
+};
+
+TraceRing& localRing()
+{
+    thread_local TraceRingHolder holder;
+    if(!holder.ring)
+        holder.ring = acquireRing();
+    return *holder.ring;
+}
+
+void record(const Trace::Event& event)
+{
+    auto& ring = localRing();
+    const auto index = ring.head.load(std::memory_order_relaxed);
+    ring.events[index & ring.mask] = event;
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+void appendEscaped(std::string& out, const std::string& s)
+{
+    for(const auto c: s)
+    {
+        if(c == '"' || c == '\\')
+            out += '\\';
+        if(static_cast<unsigned char>(c) >= 0x20)
+            out += c;
+    }
+}
+
+}
+
+// ───── CLASS ─────
+
+Trace::Scope::Scope(const char* category, const char* name, const void* id, std::uint64_t value) :
+    _category(category), _name(name), _id(id), _value(value), _begin(0), _enabled(Trace::isEnabled())
+{
+    if(_enabled)
+        _begin = Trace::now();
+}
+
+Trace::Scope::~Scope()
+{
+    if(_enabled)
+        Trace::complete(_category, _name, _id, _begin, Trace::now() - _begin, _value);
+}
+
+void Trace::setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+void Trace::setBufferSize(std::size_t size)
+{
+    std::size_t powerOfTwo = 16;
+    while(powerOfTwo < size) powerOfTwo <<= 1;
+    registry().bufferSize.store(powerOfTwo);
+}
+
+std::size_t Trace::bufferSize() { return registry().bufferSize.load(); }
+
+std::uint64_t Trace::now()
+{
+    return std::uint64_t(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+void Trace::instant(const char* category, const char* name, const void* id, std::uint64_t value)
+{
+    Event e;
+    e.category = category;
+    e.name = name;
+    e.id = id;
+    e.timestamp = now();
+    e.value = value;
+    e.phase = 'i';
+    record(e);
+}
+
+void Trace::complete(const char* category, const char* name, const void* id, std::uint64_t begin,
+    std::uint64_t duration, std::uint64_t value)
+{
+    Event e;
+    e.category = category;
+    e.name = name;
+    e.id = id;
+    e.timestamp = begin;
+    e.duration = duration;
+    e.value = value;
+    e.phase = 'X';
+    record(e);
+}
+
+std::string Trace::toChromeJson()
+{
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char line[512];
+
+    for(const auto& ring: r.rings)
+    {
+        out += first ? "" : ",";
+        first = false;
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(ring->threadId) +
+               ",\"args\":{\"name\":\"";
+        appendEscaped(out, ring->threadName);
+        out += "\"}}";
+
+        const auto head = ring->head.load(std::memory_order_acquire);
+        const auto size = std::uint64_t(ring->events.size());
+        const auto begin = std::max(ring->tail.load(), head > size ? head - size : 0);
+
+        for(auto i = begin; i < head; ++i)
+        {
+            const auto& e = ring->events[i & ring->mask];
+            if(!e.name)
+                continue;
+
+            const auto length = e.phase == 'X' ?
+                std::snprintf(line, sizeof(line),
+                    ",{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%" PRIu64 ",\"dur\":%" PRIu64
+                    ",\"pid\":1,\"tid\":%" PRIu64 ",\"args\":{\"id\":\"%p\",\"value\":%" PRIu64 "}}",
+                    e.name, e.category ? e.category : "", e.timestamp, e.duration, ring->threadId, e.id, e.value) :
+                std::snprintf(line, sizeof(line),
+                    ",{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"s\":\"t\",\"ts\":%" PRIu64
+                    ",\"pid\":1,\"tid\":%" PRIu64 ",\"args\":{\"id\":\"%p\",\"value\":%" PRIu64 "}}",
+                    e.name, e.category ? e.category : "", e.phase, e.timestamp, ring->threadId, e.id, e.value);
+            if(length <= 0 || std::size_t(length) >= sizeof(line))
+                continue;
+
+            out.append(line, std::size_t(length));
+        }
+    }
+
+    out += "]}";
+    return out;
+}
+
+bool Trace::dump(const QString& path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    const auto json = toChromeJson();
+    return file.write(json.data(), qint64(json.size())) == qint64(json.size());
+}
+
+void Trace::clear()
+{
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for(const auto& ring: r.rings) ring->tail.store(ring->head.load(std::memory_order_acquire));
+}
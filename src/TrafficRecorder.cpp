@@ -0,0 +1,229 @@
+// ───── INCLUDE ─────
+
+// Library Headers
+#include <Net/Tcp/TrafficRecorder.hpp>
+#include <Net/Tcp/Logger.hpp>
+
+// Qt Headers
+#include <QtCore/QDateTime>
+#include <QtCore/QtEndian>
+
+// Stl Headers
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+// ───── DECLARATION ─────
+
+using namespace net::tcp;
+
+// clang-format off
+#define LOG_INFO(str, ...)       NETTCP_LOG(Logger::UTILS, NETTCP_UTILS_LOG_LEVEL, spdlog::level::info, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+#define LOG_ERR(str, ...)        NETTCP_LOG(Logger::UTILS, NETTCP_UTILS_LOG_LEVEL, spdlog::level::err, "[{}] " str, (void*)(this), ## __VA_ARGS__)
+// clang-format on
+
+const char TrafficRecorder::magic[7] = {'N', 'T', 'C', 'P', 'R', 'E', 'C'};
+const std::uint8_t TrafficRecorder::version;
+const std::size_t TrafficRecorder::headerSize;
+const std::size_t TrafficRecorder::chunkHeaderSize;
+
+// Preallocate the file by block to avoid a remap for each chunk
+static const std::uint64_t minGrowSize = 1024 * 1024;
+static const std::uint64_t maxGrowSize = 64 * 1024 * 1024;
+
+// ───── CLASS ─────
+
+std::shared_ptr<TrafficRecorder> TrafficRecorder::open(const QString& path)
+{
+    static std::mutex registryMutex;
+    static std::map<QString, std::weak_ptr<TrafficRecorder>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    auto recorder = registry[path].lock();
+    if(!recorder)
+    {
+        recorder = std::shared_ptr<TrafficRecorder>(new TrafficRecorder(path));
+        if(!recorder->isOpen())
+            return nullptr;
+        registry[path] = recorder;
+    }
+    return recorder;
+}
+
+TrafficRecorder::TrafficRecorder(const QString& path) : _file(path)
+{
+    if(!_file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+    {
+        LOG_ERR("Fail to open record file {} : {}", qPrintable(path), qPrintable(_file.errorString()));
+        return;
+    }
+
+    _clock.start();
+    if(!reserve(headerSize))
+    {
+        close();
+        return;
+    }
+
+    std::memcpy(_map, magic, sizeof(magic));
+    _map[7] = version;
+    qToLittleEndian<quint64>(quint64(QDateTime::currentMSecsSinceEpoch()), _map + 8);
+    _size = headerSize;
+
+    LOG_INFO("Record traffic to {}", qPrintable(path));
+}
+
+TrafficRecorder::~TrafficRecorder() { close(); }
+
+void TrafficRecorder::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(_map)
+    {
+        _file.unmap(_map);
+        _map = nullptr;
+    }
+    if(_file.isOpen())
+    {
+        // Remove preallocated space
+        _file.resize(qint64(_size));
+        _file.close();
+    }
+    _capacity = 0;
+}
+
+bool TrafficRecorder::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _map != nullptr;
+}
+
+QString TrafficRecorder::path() const { return _file.fileName(); }
+
+std::uint64_t TrafficRecorder::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+std::uint32_t TrafficRecorder::newConnectionId() { return _nextConnectionId.fetch_add(1); }
+
+bool TrafficRecorder::reserve(std::size_t length)
+{
+    if(_size + length <= _capacity)
+        return true;
+
+    const auto grow = std::min(std::max(_capacity, minGrowSize), maxGrowSize);
+    const auto capacity = std::max(_capacity + grow, _size + length);
+
+    if(_map)
+    {
+        _file.unmap(_map);
+        _map = nullptr;
+    }
+    _capacity = 0;
+
+    if(!_file.resize(qint64(capacity)))
+    {
+        LOG_ERR("Fail to grow record file to {} bytes : {}", capacity, qPrintable(_file.errorString()));
+        return false;
+    }
+
+    _map = _file.map(0, qint64(capacity));
+    if(!_map)
+    {
+        LOG_ERR("Fail to map record file : {}", qPrintable(_file.errorString()));
+        return false;
+    }
+
+    _capacity = capacity;
+    return true;
+}
+
+void TrafficRecorder::record(std::uint32_t connection, Direction direction, const char* data, std::size_t length)
+{
+    if(!length)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if(!_file.isOpen() || !reserve(chunkHeaderSize + length) || !_map)
+        return;
+
+    auto* chunk = _map + _size;
+    qToLittleEndian<quint64>(quint64(_clock.nsecsElapsed() / 1000), chunk);
+    qToLittleEndian<quint32>(connection, chunk + 8);
+    chunk[12] = uchar(direction);
+    qToLittleEndian<quint32>(quint32(length), chunk + 13);
+    std::memcpy(chunk + chunkHeaderSize, data, length);
+
+    _size += chunkHeaderSize + length;
+}
+
+bool TrafficReader::open(const QString& path)
+{
+    close();
+
+    _file.setFileName(path);
+    if(!_file.open(QIODevice::ReadOnly))
+        return false;
+
+    _fileSize = std::uint64_t(_file.size());
+    if(_fileSize < TrafficRecorder::headerSize)
+    {
+        close();
+        return false;
+    }
+
+    _map = _file.map(0, qint64(_fileSize));
+    if(!_map || std::memcmp(_map, TrafficRecorder::magic, sizeof(TrafficRecorder::magic)) != 0 ||
+        _map[7] != TrafficRecorder::version)
+    {
+        close();
+        return false;
+    }
+
+    _startTime = qFromLittleEndian<quint64>(_map + 8);
+    _offset = TrafficRecorder::headerSize;
+    return true;
+}
+
+void TrafficReader::close()
+{
+    if(_map)
+        _file.unmap(const_cast<uchar*>(_map));
+    _map = nullptr;
+    _file.close();
+    _fileSize = 0;
+    _offset = 0;
+    _startTime = 0;
+}
+
+bool TrafficReader::isOpen() const { return _map != nullptr; }
+
+std::uint64_t TrafficReader::startTime() const { return _startTime; }
+
+bool TrafficReader::next(Chunk& chunk)
+{
+    if(!_map || _offset + TrafficRecorder::chunkHeaderSize > _fileSize)
+        return false;
+
+    const auto* header = _map + _offset;
+    const auto connection = qFromLittleEndian<quint32>(header + 8);
+    const auto length = qFromLittleEndian<quint32>(header + 13);
+
+    // Zeroed preallocated space of a file that wasn't closed properly
+    if(!connection || _offset + TrafficRecorder::chunkHeaderSize + length > _fileSize)
+        return false;
+
+    chunk.timestamp = qFromLittleEndian<quint64>(header);
+    chunk.connection = connection;
+    chunk.direction = TrafficRecorder::Direction(header[12]);
+    chunk.data = QByteArray(reinterpret_cast<const char*>(header + TrafficRecorder::chunkHeaderSize), int(length));
+
+    _offset += TrafficRecorder::chunkHeaderSize + length;
+    return true;
+}
+
+void TrafficReader::rewind() { _offset = _map ? TrafficRecorder::headerSize : 0; }
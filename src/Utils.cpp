@@ -6,6 +6,7 @@
 #include <Net/Tcp/Utils.hpp>
 #include <Net/Tcp/Server.hpp>
 #include <Net/Tcp/Socket.hpp>
+#include <Net/Tcp/SocketPool.hpp>
 #include <Net/Tcp/Version.hpp>
 #include <Net/Tcp/Logger.hpp>
 
@@ -22,31 +23,31 @@
 #ifdef NDEBUG
 # define LOG_DEV_DEBUG(str, ...) do {} while (0)
 #else
-# define LOG_DEV_DEBUG(str, ...) net::tcp::Logger::SOCKET->debug(str, ## __VA_ARGS__)
+# define LOG_DEV_DEBUG(str, ...) NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::debug, str, ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_INFO(str, ...)  do {} while (0)
 #else
-# define LOG_DEV_INFO(str, ...)  net::tcp::Logger::SOCKET->info( str, ## __VA_ARGS__)
+# define LOG_DEV_INFO(str, ...)  NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::info, str, ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_WARN(str, ...)  do {} while (0)
 #else
-# define LOG_DEV_WARN(str, ...)  net::tcp::Logger::SOCKET->warn( str, ## __VA_ARGS__)
+# define LOG_DEV_WARN(str, ...)  NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::warn, str, ## __VA_ARGS__)
 #endif
 
 #ifdef NDEBUG
 # define LOG_DEV_ERR(str, ...)   do {} while (0)
 #else
-# define LOG_DEV_ERR(str, ...)   net::tcp::Logger::SOCKET->error(str, ## __VA_ARGS__)
+# define LOG_DEV_ERR(str, ...)   NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::err, str, ## __VA_ARGS__)
 #endif
 
-#define LOG_DEBUG(str, ...)      net::tcp::Logger::SOCKET->debug(str, ## __VA_ARGS__)
-#define LOG_INFO(str, ...)       net::tcp::Logger::SOCKET->info( str, ## __VA_ARGS__)
-#define LOG_WARN(str, ...)       net::tcp::Logger::SOCKET->warn( str, ## __VA_ARGS__)
-#define LOG_ERR(str, ...)        net::tcp::Logger::SOCKET->error(str, ## __VA_ARGS__)
+#define LOG_DEBUG(str, ...)      NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::debug, str, ## __VA_ARGS__)
+#define LOG_INFO(str, ...)       NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::info, str, ## __VA_ARGS__)
+#define LOG_WARN(str, ...)       NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::warn, str, ## __VA_ARGS__)
+#define LOG_ERR(str, ...)        NETTCP_LOG(net::tcp::Logger::SOCKET, NETTCP_SOCKET_LOG_LEVEL, spdlog::level::err, str, ## __VA_ARGS__)
 // clang-format on
 
 // ─────────────────────────────────────────────────────────────
@@ -71,6 +72,9 @@ static void NetTcp_registerTypes()
     LOG_DEV_INFO("Register {}.Socket {}.{} to QML", *_uri, _major, _minor);
     net::tcp::Socket::registerToQml(*_uri, _major, _minor);
 
+    LOG_DEV_INFO("Register {}.SocketPool {}.{} to QML", *_uri, _major, _minor);
+    net::tcp::SocketPool::registerToQml(*_uri, _major, _minor);
+
     // Mandatory to listen to socket error since this type isn't registered by Qt
     qRegisterMetaType<QAbstractSocket::SocketState>();
 }
@@ -0,0 +1,131 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/AsyncLogSink.hpp>
+
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using AsyncLogSink = net::tcp::AsyncLogSink;
+
+namespace {
+
+// Sink that block until released, to fill the async queue
+class GateSink : public spdlog::sinks::base_sink<std::mutex>
+{
+public:
+    std::atomic<bool> open {false};
+    std::atomic<int> count {0};
+
+protected:
+    void sink_it_(const spdlog::details::log_msg&) override
+    {
+        while(!open) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++count;
+    }
+    void flush_() override {}
+};
+
+}
+
+TEST(AsyncLogSinkTests, forwardAll)
+{
+    std::ostringstream out;
+    const auto ostreamSink = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+    ostreamSink->set_pattern("%v");
+
+    const auto async = std::make_shared<AsyncLogSink>(16, AsyncLogSink::OverflowPolicy::Block);
+    async->addSink(ostreamSink);
+    spdlog::logger log("async", async);
+
+    std::string expected;
+    for(int i = 0; i < 100; ++i)
+    {
+        log.info("{}", i);
+        expected += std::to_string(i) + "\n";
+    }
+    async->flush();
+
+    ASSERT_EQ(out.str(), expected);
+    const auto stats = async->stats();
+    ASSERT_EQ(stats.queued, 100u);
+    ASSERT_EQ(stats.processed, 100u);
+    ASSERT_EQ(stats.droppedOldest + stats.droppedNewest, 0u);
+}
+
+TEST(AsyncLogSinkTests, dropNewest)
+{
+    const auto gate = std::make_shared<GateSink>();
+    const auto async = std::make_shared<AsyncLogSink>(8, AsyncLogSink::OverflowPolicy::DropNewest);
+    async->addSink(gate);
+    spdlog::logger log("async", async);
+
+    // First message is held by the gate, 8 fill the queue, the rest is dropped
+    for(int i = 0; i < 20; ++i)
+    {
+        log.info("{}", i);
+        if(i == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    gate->open = true;
+    async->flush();
+
+    const auto stats = async->stats();
+    ASSERT_EQ(stats.droppedNewest, 11u);
+    ASSERT_EQ(stats.processed, 9u);
+    ASSERT_EQ(gate->count, 9);
+}
+
+TEST(AsyncLogSinkTests, dropOldest)
+{
+    std::ostringstream out;
+    const auto ostreamSink = std::make_shared<spdlog::sinks::ostream_sink_mt>(out);
+    ostreamSink->set_pattern("%v");
+    const auto gate = std::make_shared<GateSink>();
+
+    const auto async = std::make_shared<AsyncLogSink>(8, AsyncLogSink::OverflowPolicy::DropOldest);
+    async->addSink(gate);
+    async->addSink(ostreamSink);
+    spdlog::logger log("async", async);
+
+    for(int i = 0; i < 20; ++i)
+    {
+        log.info("{}", i);
+        if(i == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    gate->open = true;
+    async->flush();
+
+    // Message 0 was being written, then only the 8 most recent are kept
+    ASSERT_EQ(out.str(), "0\n12\n13\n14\n15\n16\n17\n18\n19\n");
+    ASSERT_EQ(async->stats().droppedOldest, 11u);
+}
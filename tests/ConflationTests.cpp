@@ -0,0 +1,78 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/Socket.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+TEST(ConflationTests, conflateWhileCongested)
+{
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost, 30302));
+
+    net::tcp::Socket client;
+    client.setConflationThreshold(1024);
+    client.setConflationMaxKeys(2);
+    client.start("127.0.0.1", 30302);
+
+    for(int i = 0; i < 100 && !(server.hasPendingConnections() && client.isConnected()); ++i) QTest::qWait(10);
+    ASSERT_TRUE(client.isConnected());
+    auto* peer = server.nextPendingConnection();
+    ASSERT_NE(peer, nullptr);
+    // The peer doesn't read, far more than kernel buffers stay in the socket of the client
+    peer->setReadBufferSize(1);
+    const QByteArray bulk(32 * 1024 * 1024, 'x');
+    ASSERT_TRUE(client.send(bulk));
+    QTest::qWait(50);
+
+    // Key 1 is replaced in place, key 3 doesn't fit in 2 keys
+    ASSERT_TRUE(client.sendConflated(1, "a1"));
+    ASSERT_TRUE(client.sendConflated(2, "b1"));
+    ASSERT_TRUE(client.sendConflated(1, "a2"));
+    ASSERT_TRUE(client.sendConflated(3, "c1"));
+    ASSERT_TRUE(client.sendConflated(2, "b2"));
+
+    // Counters are reported with the bytes counter, every second
+    for(int i = 0; i < 200 && client.conflatedCount() < 2; ++i) QTest::qWait(10);
+    ASSERT_EQ(client.conflatedCount(), 2u);
+    ASSERT_EQ(client.conflationDroppedCount(), 1u);
+
+    // Held data is written once the socket drain, latest value of each key in the order of their first send
+    peer->setReadBufferSize(0);
+    QByteArray received;
+    for(int i = 0; i < 500 && received.size() < bulk.size() + 4; ++i)
+    {
+        QTest::qWait(10);
+        received.append(peer->readAll());
+    }
+    QTest::qWait(50);
+    received.append(peer->readAll());
+
+    ASSERT_EQ(received.size(), bulk.size() + 4);
+    ASSERT_TRUE(received.startsWith(bulk));
+    ASSERT_EQ(received.mid(bulk.size()), QByteArray("a2b2"));
+    ASSERT_EQ(client.queuedBytes(), 0u);
+    delete peer;
+}
@@ -0,0 +1,78 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/EventLoopMonitor.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+
+#include <memory>
+
+TEST(EventLoopMonitorTests, busyLoop)
+{
+    net::tcp::EventLoopMonitor monitor;
+    monitor.setProbePeriod(10);
+    QSignalSpy statsSpy(&monitor, &net::tcp::EventLoopMonitor::statsUpdated);
+    monitor.start();
+    ASSERT_TRUE(monitor.isActive());
+
+    // Block the event loop for 50ms every 100ms
+    QTimer busyTimer;
+    QObject::connect(&busyTimer, &QTimer::timeout,
+        []()
+        {
+            QElapsedTimer t;
+            t.start();
+            while(t.elapsed() < 50) {}
+        });
+    busyTimer.start(100);
+
+    ASSERT_TRUE(statsSpy.wait(3000));
+    EXPECT_GT(monitor.maxLag(), quint64(10000));
+    EXPECT_GT(monitor.load(), 0.2);
+    EXPECT_GT(monitor.wakeupsPerSeconds(), quint64(0));
+
+    monitor.stop();
+    EXPECT_FALSE(monitor.isActive());
+    EXPECT_EQ(monitor.maxLag(), quint64(0));
+}
+
+TEST(EventLoopMonitorTests, sharedPerThread)
+{
+    auto first = net::tcp::EventLoopMonitor::forCurrentThread();
+    auto second = net::tcp::EventLoopMonitor::forCurrentThread();
+    ASSERT_EQ(first, second);
+    ASSERT_TRUE(first->isActive());
+
+    // Released with the last socket of the thread
+    std::weak_ptr<net::tcp::EventLoopMonitor> weak = first;
+    first.reset();
+    ASSERT_FALSE(weak.expired());
+    second.reset();
+    ASSERT_TRUE(weak.expired());
+
+    auto next = net::tcp::EventLoopMonitor::forCurrentThread();
+    ASSERT_TRUE(next->isActive());
+}
@@ -0,0 +1,107 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/HostCache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using net::tcp::HostCache;
+
+class HostCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override { ttl = HostCache::instance().ttl(); }
+    void TearDown() override
+    {
+        HostCache::instance().clear();
+        HostCache::instance().setTtl(ttl);
+    }
+
+    const QList<QHostAddress> addresses {QHostAddress("10.0.0.1"), QHostAddress("::1")};
+    int ttl = 0;
+};
+
+TEST_F(HostCacheTests, lookup)
+{
+    auto& cache = HostCache::instance();
+    cache.setTtl(60000);
+
+    QList<QHostAddress> found;
+    ASSERT_FALSE(cache.lookup("cache.test", found));
+
+    cache.insert("cache.test", addresses);
+    ASSERT_TRUE(cache.lookup("cache.test", found));
+    ASSERT_EQ(found, addresses);
+    ASSERT_FALSE(cache.lookup("other.test", found));
+
+    // A failed resolution is not cached
+    cache.insert("empty.test", {});
+    ASSERT_FALSE(cache.lookup("empty.test", found));
+}
+
+TEST_F(HostCacheTests, expiry)
+{
+    auto& cache = HostCache::instance();
+    cache.setTtl(50);
+    cache.insert("cache.test", addresses);
+
+    QList<QHostAddress> found;
+    ASSERT_TRUE(cache.lookup("cache.test", found));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    found.clear();
+    ASSERT_FALSE(cache.lookup("cache.test", found));
+    ASSERT_TRUE(found.isEmpty());
+}
+
+TEST_F(HostCacheTests, remove)
+{
+    auto& cache = HostCache::instance();
+    cache.setTtl(60000);
+    cache.insert("cache.test", addresses);
+    cache.insert("other.test", addresses);
+
+    QList<QHostAddress> found;
+    cache.remove("cache.test");
+    ASSERT_FALSE(cache.lookup("cache.test", found));
+    ASSERT_TRUE(cache.lookup("other.test", found));
+
+    cache.clear();
+    ASSERT_FALSE(cache.lookup("other.test", found));
+}
+
+TEST_F(HostCacheTests, disabled)
+{
+    auto& cache = HostCache::instance();
+    cache.setTtl(60000);
+    cache.insert("cache.test", addresses);
+
+    // A ttl of 0 drop entries and doesn't keep new ones
+    cache.setTtl(0);
+    QList<QHostAddress> found;
+    ASSERT_FALSE(cache.lookup("cache.test", found));
+    cache.insert("cache.test", addresses);
+    ASSERT_FALSE(cache.lookup("cache.test", found));
+}
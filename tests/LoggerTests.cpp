@@ -0,0 +1,153 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/Logger.hpp>
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+struct ThrottleTest
+{
+    std::ostringstream out;
+    std::shared_ptr<spdlog::logger> log;
+
+    ThrottleTest()
+    {
+        const auto sink = std::make_shared<spdlog::sinks::ostream_sink_st>(out);
+        sink->set_pattern("%v");
+        log = std::make_shared<spdlog::logger>("throttle", sink);
+    }
+
+    void error(const void* object, int code)
+    {
+        NETTCP_LOG_THROTTLED(log, 0, spdlog::level::err, object, "Error {}", code);
+    }
+};
+
+}
+
+TEST(LoggerTests, throttleCollapseRepeatedMessages)
+{
+    net::tcp::Logger::setThrottlePeriod(50);
+    const auto before = net::tcp::Logger::throttleStats();
+
+    ThrottleTest test;
+    int a = 0;
+    int b = 0;
+    for(int i = 0; i < 100; ++i)
+    {
+        test.error(&a, i);
+        test.error(&b, i);
+    }
+
+    // Only the first message of each object is formatted
+    ASSERT_EQ(test.out.str(), "Error 0\nError 0\n");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    test.error(&a, 100);
+
+    const auto stats = net::tcp::Logger::throttleStats();
+    ASSERT_EQ(stats.logged - before.logged, 3u);
+    ASSERT_EQ(stats.suppressed - before.suppressed, 198u);
+
+    net::tcp::Logger::flushThrottled();
+    const auto out = test.out.str();
+    ASSERT_NE(out.find("Suppressed 99 times"), std::string::npos);
+    ASSERT_NE(out.find("Error 100"), std::string::npos);
+    ASSERT_EQ(net::tcp::Logger::throttleStats().summaries - before.summaries, 2u);
+
+    net::tcp::Logger::setThrottlePeriod(1000);
+}
+
+TEST(LoggerTests, throttleDisabled)
+{
+    net::tcp::Logger::setThrottlePeriod(0);
+
+    ThrottleTest test;
+    for(int i = 0; i < 3; ++i) test.error(&test, i);
+    ASSERT_EQ(test.out.str(), "Error 0\nError 1\nError 2\n");
+
+    net::tcp::Logger::setThrottlePeriod(1000);
+}
+
+TEST(LoggerTests, throttleByVariant)
+{
+    net::tcp::Logger::setThrottlePeriod(1000);
+
+    ThrottleTest test;
+    for(int i = 0; i < 10; ++i)
+    {
+        for(int state = 0; state < 3; ++state)
+            NETTCP_LOG_THROTTLED_BY(test.log, 0, spdlog::level::err, &test, state, "State {}", state);
+    }
+
+    // Each variant is throttled on its own, so every state is logged once
+    ASSERT_EQ(test.out.str(), "State 0\nState 1\nState 2\n");
+
+    net::tcp::Logger::flushThrottled();
+    const auto out = test.out.str();
+    std::size_t summaries = 0;
+    for(auto pos = out.find("Suppressed 9 times"); pos != std::string::npos;
+        pos = out.find("Suppressed 9 times", pos + 1))
+        ++summaries;
+    ASSERT_EQ(summaries, 3u);
+}
+
+TEST(LoggerTests, throttleSummaryCarryLastMessage)
+{
+    net::tcp::Logger::setThrottlePeriod(1000);
+
+    ThrottleTest test;
+    for(int i = 0; i < 5; ++i) test.error(&test, i);
+    ASSERT_EQ(test.out.str(), "Error 0\n");
+
+    net::tcp::Logger::flushThrottled();
+    ASSERT_NE(test.out.str().find("Suppressed 4 times"), std::string::npos);
+    ASSERT_NE(test.out.str().find("last : Error 4"), std::string::npos);
+}
+
+TEST(LoggerTests, forgetThrottledObject)
+{
+    net::tcp::Logger::setThrottlePeriod(1000);
+
+    ThrottleTest test;
+    int object = 0;
+    for(int i = 0; i < 3; ++i) test.error(&object, i);
+    const auto keys = net::tcp::Logger::throttleStats().keys;
+
+    // Pending suppressed messages are summarized, then the object start over
+    net::tcp::Logger::forgetThrottled(&object);
+    ASSERT_EQ(net::tcp::Logger::throttleStats().keys, keys - 1);
+    ASSERT_NE(test.out.str().find("Suppressed 2 times"), std::string::npos);
+    ASSERT_NE(test.out.str().find("last : Error 2"), std::string::npos);
+
+    test.error(&object, 3);
+    ASSERT_NE(test.out.str().find("Error 3"), std::string::npos);
+    net::tcp::Logger::forgetThrottled(&object);
+}
@@ -0,0 +1,68 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <Net/Tcp/MemoryPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+TEST(MemoryPoolTests, reuseFreedBlock)
+{
+    auto& pool = net::tcp::MemoryPool::instance();
+    EXPECT_EQ(net::tcp::MemoryPool::blockSize(100), 128);
+    EXPECT_EQ(net::tcp::MemoryPool::blockSize(1 << 20), 1 << 20);
+
+    auto* first = pool.allocate(100);
+    pool.deallocate(first, 100);
+
+    const auto before = pool.stats();
+    auto* second = pool.allocate(120);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(pool.stats().hits, before.hits + 1);
+    pool.deallocate(second, 120);
+
+    // Freed from another thread, reused by this one once flushed to the depot
+    std::thread([&]() { pool.deallocate(pool.allocate(100), 100); }).join();
+    EXPECT_GE(pool.stats().cachedBytes, 128);
+}
+
+TEST(MemoryPoolTests, pooledBuffer)
+{
+    net::tcp::PooledBuffer buffer;
+    EXPECT_TRUE(buffer.isEmpty());
+
+    const char hello[] = "hello";
+    for(int i = 0; i < 100; ++i) buffer.append(hello, 5);
+    EXPECT_EQ(buffer.size(), 500);
+    EXPECT_EQ(buffer.capacity(), 512);
+    EXPECT_EQ(std::memcmp(buffer.data() + 495, hello, 5), 0);
+
+    net::tcp::PooledBuffer moved(std::move(buffer));
+    EXPECT_EQ(buffer.capacity(), 0);
+    EXPECT_EQ(moved.size(), 500);
+
+    moved.release();
+    EXPECT_EQ(moved.capacity(), 0);
+}
@@ -0,0 +1,111 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <MyServer.hpp>
+#include <MySocket.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+TEST(OutboundQueueTests, sentInOrderOnceConnected)
+{
+    MyServer server;
+    MySocket client;
+    client.setOutboundQueueSize(1024);
+    client.setWatchdogPeriod(50);
+    // Nothing listen yet, the client retry every watchdogPeriod
+    client.start("127.0.0.1", 30300);
+
+    const QByteArray messages[] = {
+        QByteArray("\x06Hello", 7),
+        QByteArray("\x06World", 7),
+        QByteArray("\x04" "Bye", 5),
+    };
+    for(const auto& message: messages) ASSERT_TRUE(client.send(message));
+    ASSERT_FALSE(client.isConnected());
+    ASSERT_EQ(client.queuedBytes(), 19u);
+
+    QSignalSpy stringSpy(&server, &MyServer::stringReceived);
+    server.start("127.0.0.1", 30300);
+    for(int i = 0; i < 200 && stringSpy.count() < 3; ++i) QTest::qWait(10);
+
+    ASSERT_EQ(stringSpy.count(), 3);
+    ASSERT_EQ(stringSpy.at(0).at(0).toString(), QStringLiteral("Hello"));
+    ASSERT_EQ(stringSpy.at(1).at(0).toString(), QStringLiteral("World"));
+    ASSERT_EQ(stringSpy.at(2).at(0).toString(), QStringLiteral("Bye"));
+
+    for(int i = 0; i < 100 && client.queuedBytes(); ++i) QTest::qWait(10);
+    ASSERT_EQ(client.queuedBytes(), 0u);
+}
+
+TEST(OutboundQueueTests, messageCutByDisconnectionIsSentWhole)
+{
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress::LocalHost, 30301));
+
+    net::tcp::Socket client;
+    client.setOutboundQueueSize(64 * 1024 * 1024);
+    client.setWatchdogPeriod(50);
+    client.start("127.0.0.1", 30301);
+
+    for(int i = 0; i < 100 && !(server.hasPendingConnections() && client.isConnected()); ++i) QTest::qWait(10);
+    ASSERT_TRUE(client.isConnected());
+    auto* first = server.nextPendingConnection();
+    ASSERT_NE(first, nullptr);
+    // Stop reading, so the kernel buffers of both sides fill up
+    first->setReadBufferSize(1);
+
+    // Far more than kernel buffers, with a pattern that show where the data restart
+    QByteArray message(32 * 1024 * 1024, Qt::Uninitialized);
+    for(int i = 0; i < message.size(); ++i) message[i] = char(i % 251);
+    ASSERT_TRUE(client.send(message));
+    QTest::qWait(200);
+
+    // Part of the message is written to the kernel, the rest is still queued
+    ASSERT_GT(client.queuedBytes(), 0u);
+    ASSERT_LT(client.queuedBytes(), quint64(message.size()));
+
+    first->abort();
+    delete first;
+
+    for(int i = 0; i < 200 && !server.hasPendingConnections(); ++i) QTest::qWait(10);
+    auto* second = server.nextPendingConnection();
+    ASSERT_NE(second, nullptr);
+
+    QByteArray received;
+    for(int i = 0; i < 500 && received.size() < message.size(); ++i)
+    {
+        QTest::qWait(10);
+        received.append(second->readAll());
+    }
+    QTest::qWait(50);
+    received.append(second->readAll());
+
+    // Sent again from its first byte, and only once
+    ASSERT_EQ(received.size(), message.size());
+    ASSERT_TRUE(received == message);
+    ASSERT_EQ(client.queuedBytes(), 0u);
+    delete second;
+}
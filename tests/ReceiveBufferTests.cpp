@@ -0,0 +1,74 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/ReceiveBuffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using net::tcp::ReceiveBuffer;
+
+static void append(ReceiveBuffer& buffer, const char* data)
+{
+    const auto length = std::strlen(data);
+    std::memcpy(buffer.prepare(length), data, length);
+    buffer.commit(length);
+}
+
+TEST(ReceiveBufferTests, viewAndConsume)
+{
+    ReceiveBuffer buffer;
+    ASSERT_TRUE(buffer.isEmpty());
+
+    append(buffer, "hello");
+    append(buffer, "world");
+    ASSERT_EQ(buffer.size(), 10u);
+    ASSERT_EQ(std::memcmp(buffer.view().data, "helloworld", 10), 0);
+
+    buffer.consume(5);
+    ASSERT_EQ(buffer.size(), 5u);
+    ASSERT_EQ(std::memcmp(buffer.view().data, "world", 5), 0);
+
+    buffer.consume(100);
+    ASSERT_TRUE(buffer.isEmpty());
+}
+
+TEST(ReceiveBufferTests, compactBeforeGrowing)
+{
+    ReceiveBuffer buffer;
+    const auto capacity = net::tcp::MemoryPool::blockSize(64);
+    std::memset(buffer.prepare(capacity), 'a', capacity);
+    buffer.commit(capacity - 2);
+    buffer.consume(capacity - 4);
+
+    // 2 bytes left are moved to the front, there is room for 8 more
+    append(buffer, "bcdefgh");
+    ASSERT_EQ(buffer.capacity(), capacity);
+    ASSERT_EQ(buffer.size(), 9u);
+    ASSERT_EQ(std::memcmp(buffer.view().data, "aabcdefgh", 9), 0);
+
+    ASSERT_EQ(buffer.release(), 0u);
+    buffer.consume(9);
+    ASSERT_EQ(buffer.release(), capacity);
+    ASSERT_EQ(buffer.capacity(), 0u);
+}
@@ -0,0 +1,71 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <Net/Tcp/ReconnectPolicy.hpp>
+
+#include <gtest/gtest.h>
+
+using net::tcp::ReconnectPolicy;
+
+TEST(ReconnectPolicyTests, exponentialBackoff)
+{
+    ReconnectPolicy policy(100, 2., 1000);
+    EXPECT_EQ(policy.nextDelay(), 100u);
+    EXPECT_EQ(policy.nextDelay(), 200u);
+    EXPECT_EQ(policy.nextDelay(), 400u);
+    EXPECT_EQ(policy.nextDelay(), 800u);
+    EXPECT_EQ(policy.nextDelay(), 1000u);
+    EXPECT_EQ(policy.nextDelay(), 1000u);
+    EXPECT_EQ(policy.attempts(), 6u);
+
+    policy.reset();
+    EXPECT_EQ(policy.attempts(), 0u);
+    EXPECT_EQ(policy.nextDelay(), 100u);
+
+    // Default keep a fixed period
+    ReconnectPolicy fixed(500);
+    for(int i = 0; i < 10; ++i) EXPECT_EQ(fixed.nextDelay(), 500u);
+}
+
+TEST(ReconnectPolicyTests, jitter)
+{
+    ReconnectPolicy full(100, 2., 1000, ReconnectPolicy::Jitter::Full);
+    std::uint64_t bound = 100;
+    bool spread = false;
+    for(int i = 0; i < 20; ++i)
+    {
+        const auto delay = full.nextDelay();
+        EXPECT_LE(delay, bound);
+        spread |= delay != bound;
+        bound = std::min<std::uint64_t>(bound * 2, 1000);
+    }
+    EXPECT_TRUE(spread);
+
+    ReconnectPolicy decorrelated(100, 1., 1000, ReconnectPolicy::Jitter::Decorrelated);
+    for(int i = 0; i < 50; ++i)
+    {
+        const auto delay = decorrelated.nextDelay();
+        EXPECT_GE(delay, 100u);
+        EXPECT_LE(delay, 1000u);
+    }
+}
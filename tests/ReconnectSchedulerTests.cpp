@@ -0,0 +1,97 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <MyServer.hpp>
+#include <Net/Tcp/ReconnectScheduler.hpp>
+#include <Net/Tcp/Socket.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+
+#include <vector>
+
+using net::tcp::ReconnectScheduler;
+
+class ReconnectSchedulerTests : public ::testing::Test
+{
+protected:
+    void SetUp() override { ReconnectScheduler::instance().setMaxConcurrentConnects(1); }
+    void TearDown() override { ReconnectScheduler::instance().setMaxConcurrentConnects(0); }
+};
+
+TEST_F(ReconnectSchedulerTests, grantOneAtATime)
+{
+    auto& scheduler = ReconnectScheduler::instance();
+    QObject context;
+    std::vector<ReconnectScheduler::Ticket> granted;
+    const auto first = scheduler.acquire(&context, [&](ReconnectScheduler::Ticket t) { granted.push_back(t); });
+    const auto second = scheduler.acquire(&context, [&](ReconnectScheduler::Ticket t) { granted.push_back(t); });
+    ASSERT_NE(first, 0u);
+    ASSERT_NE(second, first);
+    EXPECT_EQ(scheduler.inFlight(), 1);
+    EXPECT_EQ(scheduler.waiting(), 1);
+
+    // Granted callbacks are queued to the context
+    QTest::qWait(10);
+    ASSERT_EQ(granted, std::vector<ReconnectScheduler::Ticket>({first}));
+
+    scheduler.release(first);
+    EXPECT_EQ(scheduler.inFlight(), 1);
+    EXPECT_EQ(scheduler.waiting(), 0);
+    QTest::qWait(10);
+    ASSERT_EQ(granted, std::vector<ReconnectScheduler::Ticket>({first, second}));
+
+    scheduler.release(second);
+    EXPECT_EQ(scheduler.inFlight(), 0);
+}
+
+TEST_F(ReconnectSchedulerTests, secondSocketGrantedOnceFirstConnected)
+{
+    auto& scheduler = ReconnectScheduler::instance();
+    MyServer server;
+    server.start("127.0.0.1", 30017);
+
+    net::tcp::Socket first;
+    net::tcp::Socket second;
+    bool secondConnectedBefore = false;
+    QObject::connect(&first, &net::tcp::Socket::isConnectedChanged,
+        [&](bool connected)
+        {
+            if(connected)
+                secondConnectedBefore = second.isConnected();
+        });
+
+    first.start("127.0.0.1", 30017);
+    second.start("127.0.0.1", 30017);
+    // The second socket wait for the slot of the first one
+    EXPECT_EQ(scheduler.inFlight(), 1);
+    EXPECT_EQ(scheduler.waiting(), 1);
+
+    for(int i = 0; i < 100 && !first.isConnected(); ++i) QTest::qWait(10);
+    ASSERT_TRUE(first.isConnected());
+    EXPECT_FALSE(secondConnectedBefore);
+
+    for(int i = 0; i < 100 && !second.isConnected(); ++i) QTest::qWait(10);
+    ASSERT_TRUE(second.isConnected());
+    EXPECT_EQ(scheduler.inFlight(), 0);
+    EXPECT_EQ(scheduler.waiting(), 0);
+}
@@ -0,0 +1,249 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/FramedSocketWorker.hpp>
+#include <Net/Tcp/RpcSocket.hpp>
+#include <Net/Tcp/RpcSocketWorker.hpp>
+#include <Net/Tcp/Server.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+
+#include <algorithm>
+#include <vector>
+
+using net::tcp::FramedSocketWorker;
+using net::tcp::RpcReply;
+using net::tcp::RpcSocket;
+using net::tcp::RpcSocketWorker;
+
+// Drop pings while deaf, like a peer that hang without closing the connection
+class DeafRpcWorker : public RpcSocketWorker
+{
+public:
+    static bool deaf;
+
+protected:
+    void onControlFrameReceived(const QByteArray& payload) override
+    {
+        if(!deaf)
+            RpcSocketWorker::onControlFrameReceived(payload);
+    }
+};
+
+bool DeafRpcWorker::deaf = false;
+
+class DeafRpcSocket : public RpcSocket
+{
+public:
+    using RpcSocket::RpcSocket;
+
+protected:
+    RpcSocketWorker* createRpcWorker() override { return new DeafRpcWorker; }
+};
+
+class RpcEchoServer : public net::tcp::Server
+{
+public:
+    bool answer = true;
+
+protected:
+    net::tcp::Socket* newSocket(QObject* parent) override
+    {
+        auto* socket = new DeafRpcSocket(parent);
+        QObject::connect(socket, &RpcSocket::requestReceived, socket,
+            [this, socket](quint64 id, const QByteArray& payload)
+            {
+                if(answer)
+                    socket->reply(id, payload);
+            });
+        return socket;
+    }
+};
+
+class RpcSocketTests : public ::testing::Test
+{
+public:
+    RpcEchoServer server;
+    RpcSocket client;
+
+    void TearDown() override { DeafRpcWorker::deaf = false; }
+
+    void connect(quint16 port)
+    {
+        QSignalSpy connectedSpy(&client, &RpcSocket::isConnectedChanged);
+        server.start("127.0.0.1", port);
+        client.start("127.0.0.1", port);
+        if(!client.isConnected())
+        {
+            ASSERT_TRUE(connectedSpy.wait());
+        }
+    }
+
+    static void waitFinished(const std::vector<RpcReply*>& replies)
+    {
+        const auto allFinished = [&replies]()
+        { return std::all_of(replies.begin(), replies.end(), [](RpcReply* reply) { return reply->isFinished(); }); };
+        for(int i = 0; i < 100 && !allFinished(); ++i) QTest::qWait(50);
+    }
+};
+
+TEST_F(RpcSocketTests, frameHeader)
+{
+    const auto header = FramedSocketWorker::encodeHeader(1234, 0x5);
+    ASSERT_EQ(FramedSocketWorker::headerPayloadSize(header), 1234u);
+    ASSERT_EQ(FramedSocketWorker::headerFlags(header), 0x5);
+    ASSERT_EQ(FramedSocketWorker::headerFlags(FramedSocketWorker::encodeHeader(FramedSocketWorker::maxPayloadSize)), 0);
+}
+
+TEST_F(RpcSocketTests, pipelinedRequests)
+{
+    client.setUseWorkerThread(true);
+    connect(30100);
+
+    std::vector<RpcReply*> replies;
+    for(int i = 0; i < 1000; ++i) replies.push_back(client.request(QByteArray::number(i)));
+    waitFinished(replies);
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(replies[i]->status(), RpcReply::Status::Finished);
+        ASSERT_EQ(replies[i]->payload(), QByteArray::number(i));
+    }
+    ASSERT_EQ(client.pendingRequests(), 0);
+}
+
+TEST_F(RpcSocketTests, requestTimeout)
+{
+    server.answer = false;
+    connect(30101);
+
+    std::vector<RpcReply*> replies = {client.request("late", 200)};
+    waitFinished(replies);
+
+    ASSERT_EQ(replies[0]->status(), RpcReply::Status::TimedOut);
+    ASSERT_EQ(client.pendingRequests(), 0);
+}
+
+TEST_F(RpcSocketTests, requestAbortedWhenStopped)
+{
+    std::vector<RpcReply*> replies = {client.request("not running")};
+    waitFinished(replies);
+    ASSERT_EQ(replies[0]->status(), RpcReply::Status::Aborted);
+
+    server.answer = false;
+    connect(30102);
+    replies = {client.request("lost")};
+    client.stop();
+    ASSERT_EQ(replies[0]->status(), RpcReply::Status::Aborted);
+}
+
+TEST_F(RpcSocketTests, heartbeatMeasureRoundTrip)
+{
+    client.setHeartbeatPeriod(100);
+    connect(30103);
+
+    QSignalSpy rttSpy(&client, &RpcSocket::heartbeatRttChanged);
+    for(int i = 0; i < 20 && !client.heartbeatRtt(); ++i) rttSpy.wait(100);
+    ASSERT_GT(client.heartbeatRtt(), 0u);
+    ASSERT_TRUE(client.isConnected());
+}
+
+TEST_F(RpcSocketTests, heartbeatCloseAfterMaxMissed)
+{
+    client.setHeartbeatPeriod(100);
+    client.setHeartbeatMaxMissed(2);
+    client.setWatchdogPeriod(50);
+    connect(30105);
+
+    QSignalSpy rttSpy(&client, &RpcSocket::heartbeatRttChanged);
+    for(int i = 0; i < 20 && !client.heartbeatRtt(); ++i) rttSpy.wait(100);
+    ASSERT_GT(client.heartbeatRtt(), 0u);
+
+    // The server stop answering, the client close after 2 periods without pong
+    DeafRpcWorker::deaf = true;
+    for(int i = 0; i < 100 && client.isConnected(); ++i) QTest::qWait(10);
+    ASSERT_FALSE(client.isConnected());
+
+    // Reconnected by the watchdog, the round trip of the previous connection is forgotten
+    for(int i = 0; i < 100 && !client.isConnected(); ++i) QTest::qWait(10);
+    ASSERT_TRUE(client.isConnected());
+    ASSERT_EQ(client.heartbeatRtt(), 0u);
+    ASSERT_EQ(client.heartbeatJitter(), 0u);
+}
+
+TEST_F(RpcSocketTests, heartbeatDoesNotKeepConnectionAwake)
+{
+    client.setHeartbeatPeriod(100);
+    client.setIdleTimeout(200);
+    server.setIdleTimeout(200);
+    connect(30106);
+    for(int i = 0; i < 100 && server.count() < 1; ++i) QTest::qWait(10);
+    ASSERT_EQ(server.count(), 1);
+
+    QSignalSpy rttSpy(&client, &RpcSocket::heartbeatRttChanged);
+    for(int i = 0; i < 20 && !client.heartbeatRtt(); ++i) rttSpy.wait(100);
+    ASSERT_GT(client.heartbeatRtt(), 0u);
+
+    // Pings and pongs flow every 100 ms, both ends still park after one or two idle periods
+    for(int i = 0; i < 100 && !(client.isIdle() && server.at(0)->isIdle()); ++i) QTest::qWait(10);
+    ASSERT_TRUE(client.isIdle());
+    ASSERT_TRUE(server.at(0)->isIdle());
+
+    // Heartbeats keep measuring while parked
+    QTest::qWait(300);
+    ASSERT_TRUE(client.isConnected());
+    ASSERT_TRUE(client.isIdle());
+
+    // A request is traffic and wake the connection
+    std::vector<RpcReply*> replies = {client.request("wake")};
+    waitFinished(replies);
+    ASSERT_EQ(replies[0]->status(), RpcReply::Status::Finished);
+    ASSERT_FALSE(client.isIdle());
+}
+
+TEST_F(RpcSocketTests, broadcastWriteFrames)
+{
+    connect(30104);
+    for(int i = 0; i < 100 && server.count() < 1; ++i) QTest::qWait(10);
+    ASSERT_EQ(server.count(), 1);
+
+    // RpcSocketWorker message : type, 64 bits big endian id, then the payload
+    QByteArray message(RpcSocketWorker::messageHeaderSize, 0);
+    message[0] = char(RpcSocketWorker::MessageType::Request);
+    message[RpcSocketWorker::messageHeaderSize - 1] = 42;
+    message.append("broadcast");
+
+    QSignalSpy requestSpy(&client, &RpcSocket::requestReceived);
+    ASSERT_EQ(server.broadcast(message), 1);
+    ASSERT_TRUE(requestSpy.wait());
+    ASSERT_EQ(requestSpy.first().at(0).toULongLong(), 42u);
+    ASSERT_EQ(requestSpy.first().at(1).toByteArray(), QByteArray("broadcast"));
+
+    // The stream is still in sync
+    std::vector<RpcReply*> replies = {client.request("after broadcast")};
+    waitFinished(replies);
+    ASSERT_EQ(replies[0]->status(), RpcReply::Status::Finished);
+    ASSERT_EQ(replies[0]->payload(), QByteArray("after broadcast"));
+    ASSERT_TRUE(client.isConnected());
+}
@@ -0,0 +1,93 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/SendScheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using net::tcp::SendScheduler;
+
+TEST(SendSchedulerTests, strictPriority)
+{
+    SendScheduler scheduler(3);
+    scheduler.enqueue(2, "low");
+    scheduler.enqueue(1, "normal");
+    scheduler.enqueue(0, "high");
+    EXPECT_EQ(scheduler.queuedBytes(), 13u);
+
+    SendScheduler::Chunk chunk;
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.lane, 0);
+    EXPECT_EQ(chunk.data, QByteArray("high"));
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.lane, 1);
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.lane, 2);
+    EXPECT_FALSE(scheduler.next(chunk));
+    EXPECT_TRUE(scheduler.isEmpty());
+    EXPECT_EQ(scheduler.queuedBytes(), 0u);
+}
+
+TEST(SendSchedulerTests, highPriorityInterleaveBetweenChunks)
+{
+    SendScheduler scheduler(2, SendScheduler::Policy::StrictPriority, 4);
+    scheduler.enqueue(1, "0123456789");
+
+    SendScheduler::Chunk chunk;
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.data, QByteArray("0123"));
+    EXPECT_TRUE(chunk.more);
+
+    scheduler.enqueue(0, "ping");
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.lane, 0);
+    EXPECT_EQ(chunk.data, QByteArray("ping"));
+    EXPECT_FALSE(chunk.more);
+
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.data, QByteArray("4567"));
+    EXPECT_TRUE(chunk.more);
+    ASSERT_TRUE(scheduler.next(chunk));
+    EXPECT_EQ(chunk.data, QByteArray("89"));
+    EXPECT_FALSE(chunk.more);
+    EXPECT_FALSE(scheduler.next(chunk));
+}
+
+TEST(SendSchedulerTests, weightedRoundRobin)
+{
+    SendScheduler scheduler(2, SendScheduler::Policy::WeightedRoundRobin);
+    scheduler.setWeight(0, 3);
+    for(int i = 0; i < 6; ++i)
+    {
+        scheduler.enqueue(0, "a");
+        scheduler.enqueue(1, "b");
+    }
+
+    std::vector<int> lanes;
+    SendScheduler::Chunk chunk;
+    while(scheduler.next(chunk)) lanes.push_back(chunk.lane);
+
+    const std::vector<int> expected = {0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 1, 1};
+    EXPECT_EQ(lanes, expected);
+}
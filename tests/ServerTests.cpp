@@ -183,6 +183,125 @@ TEST_F(ServerTests, echoTestWorkerThreadClientServerDelay)
     echoTest(30010);
 }
 
+TEST_F(ServerTests, broadcast)
+{
+    MySocket otherClient;
+    server.setUseWorkerThread(true);
+    QSignalSpy connectedSpy(&client, &MySocket::isConnectedChanged);
+    QSignalSpy otherConnectedSpy(&otherClient, &MySocket::isConnectedChanged);
+    server.start("127.0.0.1", 30011);
+    client.start("127.0.0.1", 30011);
+    otherClient.start("127.0.0.1", 30011);
+    if(!client.isConnected())
+    {
+        ASSERT_TRUE(connectedSpy.wait());
+    }
+    if(!otherClient.isConnected())
+    {
+        ASSERT_TRUE(otherConnectedSpy.wait());
+    }
+    for(int i = 0; i < 100 && server.count() < 2; ++i) QTest::qWait(10);
+    ASSERT_EQ(server.count(), 2);
+
+    QSignalSpy clientStringAvailable(&client, &MySocket::stringReceived);
+    QSignalSpy otherClientStringAvailable(&otherClient, &MySocket::stringReceived);
+    // MySocketWorker protocol : 1 byte size, then a null terminated string
+    const QByteArray message("\x06Hello", 7);
+    ASSERT_EQ(server.broadcast(message), 2);
+    if(clientStringAvailable.isEmpty())
+    {
+        ASSERT_TRUE(clientStringAvailable.wait());
+    }
+    if(otherClientStringAvailable.isEmpty())
+    {
+        ASSERT_TRUE(otherClientStringAvailable.wait());
+    }
+    ASSERT_EQ(clientStringAvailable.takeFirst().at(0).toString(), QString("Hello"));
+    ASSERT_EQ(otherClientStringAvailable.takeFirst().at(0).toString(), QString("Hello"));
+
+    ASSERT_EQ(server.broadcast(message, [](const net::tcp::Socket*) { return false; }), 0);
+}
+
+TEST_F(ServerTests, recycledSocketServeNextClient)
+{
+    server.setSocketPoolSize(1);
+    server.start("127.0.0.1", 30014);
+
+    // First client leave a partial string in the server worker
+    client.start("127.0.0.1", 30014);
+    for(int i = 0; i < 100 && server.count() < 1; ++i) QTest::qWait(10);
+    ASSERT_EQ(server.count(), 1);
+    auto* first = server.at(0);
+    ASSERT_TRUE(client.send(QByteArray("\x06He", 3)));
+    // Reported by the bytes counter every second
+    for(int i = 0; i < 200 && first->rxBytesTotal() < 3; ++i) QTest::qWait(10);
+    ASSERT_EQ(first->rxBytesTotal(), 3u);
+
+    client.stop();
+    for(int i = 0; i < 100 && server.count(); ++i) QTest::qWait(10);
+    ASSERT_EQ(server.count(), 0);
+    QTest::qWait(50);
+
+    // The pooled socket serve the next client, from a clean state
+    MySocket otherClient;
+    otherClient.start("127.0.0.1", 30014);
+    for(int i = 0; i < 100 && !(otherClient.isConnected() && server.count() == 1); ++i) QTest::qWait(10);
+    ASSERT_EQ(server.count(), 1);
+    ASSERT_EQ(server.at(0), first);
+    ASSERT_EQ(first->peerPort(), otherClient.localPort());
+    ASSERT_EQ(first->rxBytesTotal(), 0u);
+
+    QSignalSpy stringSpy(&otherClient, &MySocket::stringReceived);
+    Q_EMIT otherClient.sendString("World");
+    ASSERT_TRUE(stringSpy.wait());
+    ASSERT_EQ(stringSpy.first().at(0).toString(), QStringLiteral("World"));
+}
+
+TEST_F(ServerTests, readBudgetYieldToOtherClients)
+{
+    // Every server client share the thread of the server
+    server.setReadBudget(16);
+    server.start("127.0.0.1", 30016);
+    MySocket otherClient;
+    client.start("127.0.0.1", 30016);
+    otherClient.start("127.0.0.1", 30016);
+    for(int i = 0; i < 100 && !(client.isConnected() && otherClient.isConnected() && server.count() == 2); ++i)
+        QTest::qWait(10);
+    ASSERT_EQ(server.count(), 2);
+
+    auto* firehose = server.at(0)->peerPort() == client.localPort() ? server.at(0) : server.at(1);
+    ASSERT_EQ(firehose->peerPort(), client.localPort());
+
+    int byeCount = 0;
+    int byeBeforeHi = -1;
+    QObject::connect(&server, &MyServer::stringReceived,
+        [&](const QString& s)
+        {
+            if(s == QStringLiteral("Bye"))
+                ++byeCount;
+            else if(s == QStringLiteral("Hi"))
+                byeBeforeHi = byeCount;
+        });
+
+    // MySocketWorker protocol : 1 byte size, then a null terminated string
+    const int byeTotal = 100000;
+    const QByteArray bye("\x04" "Bye", 5);
+    ASSERT_TRUE(client.send(bye.repeated(byeTotal)));
+    Q_EMIT otherClient.sendString("Hi");
+
+    for(int i = 0; i < 1000 && (byeBeforeHi < 0 || byeCount < byeTotal); ++i) QTest::qWait(10);
+    ASSERT_EQ(byeCount, byeTotal);
+    // The other client is served long before the firehose is drained
+    ASSERT_GE(byeBeforeHi, 0);
+    EXPECT_LT(byeBeforeHi, byeTotal / 10);
+
+    // Reported by the bytes counter every second
+    for(int i = 0; i < 200 && !firehose->readBudgetExceededCount(); ++i) QTest::qWait(10);
+    EXPECT_GT(firehose->readBudgetExceededCount(), 0u);
+    EXPECT_GT(firehose->readDispatchTimeMax(), 0u);
+    EXPECT_GT(firehose->readRequeueLatencyMax(), 0u);
+}
+
 TEST_F(ServerTests, DISABLED_fuzzDisconnectionClientServer)
 {
     clientSendError = true;
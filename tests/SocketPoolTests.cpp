@@ -0,0 +1,166 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <MyServer.hpp>
+#include <Net/Tcp/SocketPool.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+
+#include <set>
+
+using net::tcp::Socket;
+using net::tcp::SocketPool;
+using net::tcp::SocketWorker;
+
+// Socket without worker, so its start always fail
+class NoWorkerSocket : public Socket
+{
+public:
+    using Socket::Socket;
+
+protected:
+    SocketWorker* createWorker() override { return nullptr; }
+};
+
+// First member fail to start, the others are regular sockets
+class FailFirstPool : public SocketPool
+{
+public:
+    int created = 0;
+
+protected:
+    Socket* newSocket(QObject* parent) override
+    {
+        return created++ ? new Socket(parent) : new NoWorkerSocket(parent);
+    }
+};
+
+static bool allConnected(SocketPool& pool)
+{
+    for(auto* socket: pool)
+        if(!socket->isConnected())
+            return false;
+    return pool.count() > 0;
+}
+
+class SocketPoolTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        server.start("127.0.0.1", 30200);
+        // Members write in this thread, so bytes given to send stay queued until the event loop run
+        pool.setUseWorkerThread(false);
+        pool.setPoolSize(3);
+        pool.start("127.0.0.1", 30200);
+        for(int i = 0; i < 100 && !allConnected(pool); ++i) QTest::qWait(10);
+        ASSERT_TRUE(allConnected(pool));
+    }
+
+    MyServer server;
+    SocketPool pool;
+};
+
+TEST_F(SocketPoolTests, roundRobin)
+{
+    pool.setStrategy(int(SocketPool::Strategy::RoundRobin));
+
+    std::set<Socket*> picked;
+    auto* first = pool.pick();
+    picked.insert(first);
+    picked.insert(pool.pick());
+    picked.insert(pool.pick());
+
+    // Every member once, then the first one again
+    ASSERT_EQ(picked.size(), 3u);
+    ASSERT_EQ(pool.pick(), first);
+}
+
+TEST_F(SocketPoolTests, leastQueued)
+{
+    pool.setStrategy(int(SocketPool::Strategy::LeastQueued));
+
+    auto* busy = pool.pick();
+    ASSERT_NE(busy, nullptr);
+    ASSERT_TRUE(busy->send(QByteArray(1024 * 1024, 'a')));
+    ASSERT_GT(busy->queuedBytes(), 0u);
+
+    // Other members are idle
+    for(int i = 0; i < 3; ++i) ASSERT_NE(pool.pick(), busy);
+
+    // Once written, the member can be picked again
+    for(int i = 0; i < 200 && busy->queuedBytes(); ++i) QTest::qWait(10);
+    ASSERT_EQ(busy->queuedBytes(), 0u);
+}
+
+TEST_F(SocketPoolTests, keyAffinity)
+{
+    pool.setStrategy(int(SocketPool::Strategy::KeyAffinity));
+
+    for(quint64 key = 0; key < 6; ++key)
+    {
+        ASSERT_EQ(pool.pick(key), pool.at(int(key % 3)));
+        ASSERT_EQ(pool.pick(key), pool.pick(key));
+    }
+
+    // The key move to the next member while its member is down
+    pool.at(1)->stop();
+    ASSERT_EQ(pool.pick(1), pool.at(2));
+    ASSERT_EQ(pool.pick(4), pool.at(2));
+    ASSERT_EQ(pool.pick(0), pool.at(0));
+}
+
+TEST(SocketPoolReplaceTests, replaceOnlyMembersThatFailedToStart)
+{
+    // No server : the regular member stay disconnected and retry on its own
+    FailFirstPool pool;
+    pool.setUseWorkerThread(false);
+    pool.setPoolSize(2);
+    pool.setWatchdogPeriod(50);
+    pool.setReconnectMultiplier(2.);
+    pool.setReplaceTimeout(1);
+    pool.start("127.0.0.1", 30201);
+
+    ASSERT_EQ(pool.count(), 2);
+    auto* failed = pool.at(0);
+    auto* disconnected = pool.at(1);
+    ASSERT_FALSE(failed->isRunning());
+    ASSERT_TRUE(disconnected->isRunning());
+    // Settings of the pool are forwarded to members
+    ASSERT_EQ(disconnected->watchdogPeriod(), 50u);
+    ASSERT_EQ(disconnected->reconnectMultiplier(), 2.);
+
+    QSignalSpy replacedSpy(&pool, &SocketPool::memberReplaced);
+    ASSERT_TRUE(replacedSpy.wait(3000));
+    ASSERT_EQ(replacedSpy.count(), 1);
+    ASSERT_EQ(replacedSpy.at(0).at(0).toInt(), 0);
+    ASSERT_EQ(pool.replacedCount(), 1u);
+
+    // The failed member is replaced at the same index, the disconnected one is kept with its backoff
+    ASSERT_NE(pool.at(0), failed);
+    ASSERT_TRUE(pool.at(0)->isRunning());
+    ASSERT_EQ(pool.at(1), disconnected);
+    ASSERT_TRUE(disconnected->isRunning());
+    ASSERT_FALSE(disconnected->isConnected());
+}
@@ -20,10 +20,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <MyServer.hpp>
+#include <MySocket.hpp>
 #include <Net/Tcp/Socket.hpp>
 
 #include <gtest/gtest.h>
 #include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QElapsedTimer>
 
 class SocketNullWorkerTests : public net::tcp::Socket
 {
@@ -36,3 +40,107 @@ TEST(SocketTests, nullWorker)
     SocketNullWorkerTests s;
     s.start("127.0.0.1", 9999);
 }
+
+TEST(SocketTests, connectTimeout)
+{
+    net::tcp::Socket s;
+    s.setConnectTimeout(200);
+    // No retry during the test
+    s.setWatchdogPeriod(60000);
+
+    QSignalSpy errorSpy(&s, &net::tcp::Socket::socketError);
+    QElapsedTimer elapsed;
+    elapsed.start();
+    // Non routable, the connection attempt never complete
+    s.start("10.255.255.1", 9);
+    ASSERT_TRUE(errorSpy.wait(2000));
+
+    if(errorSpy.at(0).at(0).toInt() != int(QAbstractSocket::SocketTimeoutError))
+        GTEST_SKIP() << "10.255.255.1 is rejected by the host network";
+
+    // Counted in 100 ms ticks of the timer wheel, far below the system timeout
+    ASSERT_GE(elapsed.elapsed(), 100);
+    ASSERT_LT(elapsed.elapsed(), 1000);
+    ASSERT_FALSE(s.isConnected());
+    ASSERT_TRUE(s.isRunning());
+}
+
+TEST(SocketTests, effectiveSocketOptions)
+{
+    MyServer server;
+    net::tcp::Socket client;
+    server.start("127.0.0.1", 30013);
+    client.start("127.0.0.1", 30013);
+    for(int i = 0; i < 100 && !client.isConnected(); ++i) QTest::qWait(10);
+    ASSERT_TRUE(client.isConnected());
+    ASSERT_FALSE(client.effectiveSocketOptions().value("keepAlive").toBool());
+
+    net::tcp::SocketOptions options;
+    options.keepAliveIdle = 30;
+    options.keepAliveInterval = 5;
+    options.keepAliveCount = 4;
+    options.userTimeout = 5000;
+
+    // Every option reach the worker in one call, so the readback change once
+    QSignalSpy effectiveSpy(&client, &net::tcp::Socket::effectiveSocketOptionsChanged);
+    client.setSocketOptions(options);
+    for(int i = 0; i < 100 && effectiveSpy.isEmpty(); ++i) QTest::qWait(10);
+    QTest::qWait(20);
+    ASSERT_EQ(effectiveSpy.count(), 1);
+
+    auto effective = client.effectiveSocketOptions();
+    ASSERT_TRUE(effective.value("keepAlive").toBool());
+#ifdef Q_OS_LINUX
+    ASSERT_EQ(effective.value("keepAliveIdle").toInt(), 30);
+    ASSERT_EQ(effective.value("keepAliveInterval").toInt(), 5);
+    ASSERT_EQ(effective.value("keepAliveCount").toInt(), 4);
+    ASSERT_EQ(effective.value("userTimeout").toInt(), 5000);
+#endif
+
+    // Back to 0 restore the system default
+    client.setSocketOptions(net::tcp::SocketOptions());
+    for(int i = 0; i < 100 && effectiveSpy.count() < 2; ++i) QTest::qWait(10);
+    ASSERT_EQ(effectiveSpy.count(), 2);
+
+    effective = client.effectiveSocketOptions();
+    ASSERT_FALSE(effective.value("keepAlive").toBool());
+#ifdef Q_OS_LINUX
+    ASSERT_NE(effective.value("keepAliveIdle").toInt(), 30);
+    ASSERT_EQ(effective.value("userTimeout").toInt(), 0);
+#endif
+}
+
+TEST(SocketTests, readBelowLowWatermark)
+{
+#ifndef Q_OS_LINUX
+    GTEST_SKIP() << "SO_RCVLOWAT is only supported on Linux";
+#endif
+    MyServer server;
+    MySocket client;
+    server.setReadLowWatermark(4096);
+    server.setReadMaxDelay(0);
+    server.start("127.0.0.1", 30015);
+    client.start("127.0.0.1", 30015);
+    for(int i = 0; i < 100 && (!client.isConnected() || server.count() < 1); ++i) QTest::qWait(10);
+    ASSERT_TRUE(client.isConnected());
+    ASSERT_EQ(server.count(), 1);
+
+    // Without readMaxDelay, a few bytes wait in the kernel for the watermark
+    QSignalSpy receivedSpy(&server, &MyServer::stringReceived);
+    Q_EMIT client.sendString("Hi");
+    QTest::qWait(200);
+    ASSERT_TRUE(receivedSpy.isEmpty());
+
+    // They are read once the socket is silent for readMaxDelay
+    server.at(0)->setReadMaxDelay(5);
+    ASSERT_TRUE(receivedSpy.wait(200));
+    ASSERT_EQ(receivedSpy.takeFirst().at(0).toString(), QString("Hi"));
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    Q_EMIT client.sendString("Hello");
+    for(int i = 0; i < 100 && receivedSpy.isEmpty(); ++i) QTest::qWait(1);
+    ASSERT_EQ(receivedSpy.count(), 1);
+    ASSERT_EQ(receivedSpy.takeFirst().at(0).toString(), QString("Hello"));
+    EXPECT_LT(elapsed.elapsed(), 100);
+}
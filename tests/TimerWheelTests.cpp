@@ -0,0 +1,117 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/TimerWheel.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
+#include <QtCore/QThread>
+
+#include <memory>
+
+TEST(TimerWheelTests, singleShotAndRepeat)
+{
+    net::tcp::TimerWheel wheel(10);
+    QElapsedTimer clock;
+    clock.start();
+
+    qint64 singleShotElapsed = -1;
+    int repeatCount = 0;
+    wheel.start(50, &wheel, [&]() { singleShotElapsed = clock.elapsed(); });
+    const auto repeatId = wheel.start(20, &wheel, [&]() { ++repeatCount; }, true);
+    ASSERT_EQ(wheel.size(), 2u);
+
+    QTest::qWait(200);
+
+    EXPECT_GE(singleShotElapsed, 50);
+    EXPECT_GE(repeatCount, 5);
+    EXPECT_TRUE(wheel.isActive(repeatId));
+    EXPECT_EQ(wheel.size(), 1u);
+
+    wheel.stop(repeatId);
+    const auto countAtStop = repeatCount;
+    QTest::qWait(50);
+    EXPECT_EQ(repeatCount, countAtStop);
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTests, contextDestroyed)
+{
+    net::tcp::TimerWheel wheel(10);
+    auto context = std::make_unique<QObject>();
+
+    bool fired = false;
+    const auto id = wheel.start(20, context.get(), [&]() { fired = true; });
+    context.reset();
+
+    QTest::qWait(60);
+    EXPECT_FALSE(fired);
+    EXPECT_FALSE(wheel.isActive(id));
+}
+
+TEST(TimerWheelTests, longInterval)
+{
+    // Longer than one turn of the wheel
+    net::tcp::TimerWheel wheel(1);
+    QElapsedTimer clock;
+    clock.start();
+
+    qint64 elapsed = -1;
+    wheel.start(700, &wheel, [&]() { elapsed = clock.elapsed(); });
+
+    QTest::qWait(600);
+    EXPECT_EQ(elapsed, -1);
+    QTest::qWait(300);
+    EXPECT_GE(elapsed, 700);
+}
+
+TEST(TimerWheelTests, instanceLifetime)
+{
+    // The application thread wheel is destroyed with QCoreApplication
+    EXPECT_EQ(net::tcp::TimerWheel::instance()->parent(), QCoreApplication::instance());
+
+    // One wheel per resolution
+    auto* fine = net::tcp::TimerWheel::instance(1);
+    EXPECT_EQ(fine->resolution(), 1);
+    EXPECT_EQ(fine, net::tcp::TimerWheel::instance(1));
+    EXPECT_NE(fine, net::tcp::TimerWheel::instance());
+    EXPECT_EQ(net::tcp::TimerWheel::instance()->resolution(), 100);
+
+    QThread thread;
+    auto* context = new QObject;
+    context->moveToThread(&thread);
+    QObject::connect(&thread, &QThread::finished, context, &QObject::deleteLater);
+    thread.start();
+
+    QPointer<net::tcp::TimerWheel> wheel;
+    QMetaObject::invokeMethod(
+        context, [&wheel]() { wheel = net::tcp::TimerWheel::instance(); }, Qt::BlockingQueuedConnection);
+    ASSERT_TRUE(wheel);
+    EXPECT_NE(wheel.data(), net::tcp::TimerWheel::instance());
+
+    thread.quit();
+    thread.wait();
+    EXPECT_FALSE(wheel);
+}
@@ -0,0 +1,59 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/TokenBucket.hpp>
+
+#include <gtest/gtest.h>
+
+using net::tcp::TokenBucket;
+
+TEST(TokenBucketTests, unlimited)
+{
+    TokenBucket bucket;
+    EXPECT_FALSE(bucket.isLimited());
+    bucket.consume(1 << 30);
+    EXPECT_GT(bucket.available(), 1 << 30);
+    EXPECT_EQ(bucket.delayFor(1 << 30), 0u);
+}
+
+TEST(TokenBucketTests, refillAtRate)
+{
+    TokenBucket bucket(1000, 500);
+    const auto start = TokenBucket::Clock::now();
+    EXPECT_EQ(bucket.available(start), 500);
+
+    bucket.consume(700);
+    EXPECT_EQ(bucket.available(start), -200);
+    EXPECT_EQ(bucket.delayFor(100, start), 300u);
+
+    // 100 ms refill 100 bytes
+    EXPECT_EQ(bucket.available(start + std::chrono::milliseconds(100)), -100);
+    // Never more than burst
+    EXPECT_EQ(bucket.available(start + std::chrono::seconds(10)), 500);
+    EXPECT_EQ(bucket.delayFor(10000, start + std::chrono::seconds(10)), 0u);
+}
+
+TEST(TokenBucketTests, defaultBurst)
+{
+    EXPECT_EQ(TokenBucket(1000000).burst(), 100000u);
+    EXPECT_EQ(TokenBucket(1000).burst(), 4096u);
+}
@@ -0,0 +1,115 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <Net/Tcp/Trace.hpp>
+
+#include <gtest/gtest.h>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+
+#include <string>
+#include <thread>
+
+using net::tcp::Trace;
+
+class TraceTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Trace::setEnabled(true);
+        Trace::clear();
+    }
+    void TearDown() override
+    {
+        Trace::clear();
+        Trace::setEnabled(false);
+    }
+
+    static bool contains(const std::string& json, const std::string& s) { return json.find(s) != std::string::npos; }
+};
+
+TEST_F(TraceTests, toChromeJson)
+{
+    Trace::instant("test", "instantEvent", nullptr, 42);
+    Trace::complete("test", "completeEvent", nullptr, 1000, 250, 7);
+
+    const auto json = Trace::toChromeJson();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_TRUE(contains(json, "\"ph\":\"M\""));
+    EXPECT_TRUE(contains(json, "\"name\":\"instantEvent\",\"cat\":\"test\",\"ph\":\"i\""));
+    EXPECT_TRUE(contains(json, "\"value\":42"));
+    EXPECT_TRUE(contains(json, "\"name\":\"completeEvent\",\"cat\":\"test\",\"ph\":\"X\",\"ts\":1000,\"dur\":250"));
+    EXPECT_TRUE(contains(json, "\"value\":7"));
+
+    Trace::clear();
+    const auto cleared = Trace::toChromeJson();
+    EXPECT_FALSE(contains(cleared, "instantEvent"));
+    EXPECT_FALSE(contains(cleared, "completeEvent"));
+}
+
+TEST_F(TraceTests, dump)
+{
+    Trace::instant("test", "dumpedEvent", nullptr);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = dir.filePath("trace.json");
+    ASSERT_TRUE(Trace::dump(path));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const auto content = file.readAll();
+    EXPECT_TRUE(content.contains("dumpedEvent"));
+    EXPECT_TRUE(content.endsWith("]}"));
+
+    EXPECT_FALSE(Trace::dump(dir.filePath("missing/trace.json")));
+}
+
+TEST_F(TraceTests, reuseRingOfDeadThread)
+{
+    const auto traceFrom = [](const char* threadName, const char* eventName)
+    {
+        std::thread t(
+            [&]()
+            {
+                QThread::currentThread()->setObjectName(threadName);
+                Trace::instant("test", eventName, nullptr);
+            });
+        t.join();
+    };
+
+    traceFrom("firstThread", "firstEvent");
+    auto json = Trace::toChromeJson();
+    EXPECT_TRUE(contains(json, "firstThread"));
+    EXPECT_TRUE(contains(json, "firstEvent"));
+
+    // The second thread take the ring of the first one, events of the first thread must not be exported with its name
+    traceFrom("secondThread", "secondEvent");
+    json = Trace::toChromeJson();
+    EXPECT_TRUE(contains(json, "secondThread"));
+    EXPECT_TRUE(contains(json, "secondEvent"));
+    EXPECT_FALSE(contains(json, "firstThread"));
+    EXPECT_FALSE(contains(json, "firstEvent"));
+}
@@ -0,0 +1,103 @@
+﻿// MIT License
+//
+// Copyright(c) 2020 Olivier Le Doeuff
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <MyServer.hpp>
+#include <MySocket.hpp>
+#include <Net/Tcp/TrafficRecorder.hpp>
+
+#include <gtest/gtest.h>
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+#include <QtCore/QTemporaryDir>
+
+#include <map>
+
+using net::tcp::TrafficReader;
+using net::tcp::TrafficRecorder;
+
+using Streams = std::map<std::uint32_t, QByteArray>;
+
+// Data of every chunk concatenated per connection
+static void readRecord(const QString& path, Streams& rx, Streams& tx)
+{
+    TrafficReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    TrafficReader::Chunk chunk;
+    while(reader.next(chunk))
+        (chunk.direction == TrafficRecorder::Direction::Rx ? rx : tx)[chunk.connection].append(chunk.data);
+}
+
+TEST(TrafficRecorderTests, successiveConnections)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto serverPath = dir.filePath("server.rec");
+    const auto clientPath = dir.filePath("client.rec");
+
+    {
+        MyServer server;
+        MySocket client;
+        server.setRecordPath(serverPath);
+        client.setRecordPath(clientPath);
+        server.start("127.0.0.1", 30012);
+
+        for(const auto& message: {QStringLiteral("Hello"), QStringLiteral("World")})
+        {
+            QSignalSpy connectedSpy(&client, &MySocket::isConnectedChanged);
+            client.start("127.0.0.1", 30012);
+            if(!client.isConnected())
+            {
+                ASSERT_TRUE(connectedSpy.wait());
+            }
+
+            QSignalSpy stringSpy(&client, &MySocket::stringReceived);
+            Q_EMIT client.sendString(message);
+            ASSERT_TRUE(stringSpy.wait());
+
+            // The server destroy its client, the next connection must not truncate the file
+            client.stop();
+            for(int i = 0; i < 100 && server.count(); ++i) QTest::qWait(10);
+            ASSERT_EQ(server.count(), 0);
+        }
+    }
+    // Workers are deleted later, with the last recorder reference
+    QTest::qWait(100);
+
+    // MySocketWorker protocol : 1 byte size, then a null terminated string
+    const QByteArray hello("\x06Hello", 7);
+    const QByteArray world("\x06World", 7);
+
+    Streams serverRx, serverTx;
+    readRecord(serverPath, serverRx, serverTx);
+    ASSERT_EQ(serverRx.size(), 2u);
+    ASSERT_EQ(serverRx.begin()->second, hello);
+    ASSERT_EQ(std::next(serverRx.begin())->second, world);
+    ASSERT_EQ(serverTx, serverRx);
+
+    Streams clientRx, clientTx;
+    readRecord(clientPath, clientRx, clientTx);
+    ASSERT_EQ(clientTx.size(), 2u);
+    ASSERT_EQ(clientTx.begin()->second, hello);
+    ASSERT_EQ(std::next(clientTx.begin())->second, world);
+    ASSERT_EQ(clientRx, clientTx);
+}